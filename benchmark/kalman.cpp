@@ -1,5 +1,7 @@
 #include <benchmark/benchmark.h>
 
+#include <vector>
+
 
 #include "ssmkit/map/linear_gaussian.hpp"
 #include "ssmkit/distribution/gaussian.hpp"
@@ -8,10 +10,14 @@
 #include "ssmkit/process/memoryless.hpp"
 #include "ssmkit/process/hierarchical.hpp"
 #include "ssmkit/filter/kalman.hpp"
+#include "ssmkit/filter/square_root_kalman.hpp"
+#include "ssmkit/filter/kalman_bank.hpp"
+#include "ssmkit/filter/fixed_kalman.hpp"
+#include "ssmkit/filter/unscented.hpp"
 
 using namespace ssmkit;
 
-auto make(){
+auto make_process(){
   double delta = 0.1; // sample time
   arma::mat dynamic_matrix{
       {1, 0, delta, 0}, {0, 1, 0, delta}, {0, 0, 1, 0}, {0, 0, 0, 1}};
@@ -36,16 +42,45 @@ auto make(){
   auto measurement_process =
       process::makeMemoryless(measurement_cpdf);
   
-  auto joint_process =
-      process::makeHierarchical(state_process, measurement_process);
-  
-  auto kalman = filter::makeKalman(joint_process);
+  return process::makeHierarchical(state_process, measurement_process);
+}
+
+auto make(){
+  auto kalman = filter::makeKalman(make_process());
+  kalman.initialize();
+  return kalman;
+}
+
+auto make_steady(){
+  auto kalman = filter::makeKalman(make_process());
+  kalman.solveSteadyState();
+  kalman.initialize();
+  return kalman;
+}
+
+auto make_fixed(){
+  auto kalman = filter::makeFixedKalman<4, 2>(make_process());
+  kalman.initialize();
+  return kalman;
+}
+
+auto make_square_root(){
+  auto kalman = filter::makeSquareRootKalman(make_process());
   kalman.initialize();
   return kalman;
 }
 
+auto make_unscented(){
+  auto ukf = filter::makeUnscented(make_process());
+  ukf.initialize();
+  return ukf;
+}
 
 auto kalman = make();
+auto steady_kalman = make_steady();
+auto sr_kalman = make_square_root();
+auto fixed_kalman = make_fixed();
+auto ukf = make_unscented();
 
 arma::vec meas {0, 0};
 
@@ -63,6 +98,173 @@ static void ssmkit_kalman_correct(benchmark::State& state) {
 }
 BENCHMARK(ssmkit_kalman_correct);
 
+static void ssmkit_kalman_correct_in_place(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    kalman.correctInPlace(meas);
+    benchmark::DoNotOptimize(kalman.getStateVector().memptr());
+  }
+}
+BENCHMARK(ssmkit_kalman_correct_in_place);
+
+static void ssmkit_kalman_steady_predict(benchmark::State& state) {
+  while (state.KeepRunning())
+    steady_kalman.predict();
+}
+BENCHMARK(ssmkit_kalman_steady_predict);
+
+static void ssmkit_kalman_steady_correct(benchmark::State& state) {
+  while (state.KeepRunning())
+    steady_kalman.correct(meas);
+}
+BENCHMARK(ssmkit_kalman_steady_correct);
+
+static void ssmkit_fixed_kalman_predict(benchmark::State& state) {
+  while (state.KeepRunning())
+    fixed_kalman.predict();
+}
+BENCHMARK(ssmkit_fixed_kalman_predict);
+
+arma::vec::fixed<2> fixed_meas {0, 0};
+
+static void ssmkit_fixed_kalman_correct(benchmark::State& state) {
+  while (state.KeepRunning())
+    benchmark::DoNotOptimize(fixed_kalman.correct(fixed_meas));
+}
+BENCHMARK(ssmkit_fixed_kalman_correct);
+
+static void ssmkit_square_root_kalman_predict(benchmark::State& state) {
+  while (state.KeepRunning())
+    sr_kalman.predict();
+}
+BENCHMARK(ssmkit_square_root_kalman_predict);
+
+static void ssmkit_square_root_kalman_correct(benchmark::State& state) {
+  while (state.KeepRunning())
+    sr_kalman.correct(meas);
+}
+BENCHMARK(ssmkit_square_root_kalman_correct);
+
+static void ssmkit_unscented_predict(benchmark::State& state) {
+  while (state.KeepRunning())
+    ukf.predict();
+}
+BENCHMARK(ssmkit_unscented_predict);
+
+static void ssmkit_unscented_correct(benchmark::State& state) {
+  while (state.KeepRunning())
+    ukf.correct(meas);
+}
+BENCHMARK(ssmkit_unscented_correct);
+
+// dense model of dimension n with n/2 correlated measurements
+auto make_dense_process(arma::uword n){
+  const arma::uword m = n / 2;
+  arma::mat dynamic_matrix = arma::eye<arma::mat>(n, n);
+  dynamic_matrix.diag(1).fill(0.1);
+  arma::mat dynamic_noise = 0.1 * arma::eye<arma::mat>(n, n);
+  arma::mat measurement_matrix = arma::eye<arma::mat>(m, n);
+  arma::mat measurement_noise =
+      0.1 * arma::eye<arma::mat>(m, m) + 0.01 * arma::ones<arma::mat>(m, m);
+
+  auto dynamic_cpdf = distribution::makeConditional(
+      distribution::Gaussian(n),
+      map::LinearGaussian(dynamic_matrix, dynamic_noise));
+  auto measurement_cpdf = distribution::makeConditional(
+      distribution::Gaussian(m),
+      map::LinearGaussian(measurement_matrix, measurement_noise));
+  return process::makeHierarchical(
+      process::makeMarkov(dynamic_cpdf, distribution::Gaussian(n)),
+      process::makeMemoryless(measurement_cpdf));
+}
+
+// one predict and correct of a large dense model per iteration
+static void ssmkit_kalman_dimension(benchmark::State& state) {
+  auto kalman = filter::makeKalman(make_dense_process(state.range(0)));
+  kalman.initialize();
+  arma::vec measurement = arma::zeros<arma::vec>(state.range(0) / 2);
+  while (state.KeepRunning()) {
+    kalman.predict();
+    kalman.correctInPlace(measurement);
+  }
+}
+BENCHMARK(ssmkit_kalman_dimension)->Arg(50)->Arg(100)->Arg(200)->Arg(400);
+
+// the same steps of the square-root filter, to compare with Kalman
+static void ssmkit_square_root_kalman_dimension(benchmark::State& state) {
+  auto kalman =
+      filter::makeSquareRootKalman(make_dense_process(state.range(0)));
+  kalman.initialize();
+  arma::vec measurement = arma::zeros<arma::vec>(state.range(0) / 2);
+  while (state.KeepRunning()) {
+    kalman.predict();
+    kalman.correctInPlace(measurement);
+  }
+}
+BENCHMARK(ssmkit_square_root_kalman_dimension)->Arg(50)->Arg(100)->Arg(200);
+
+// constant velocity model in the given number of axes: 4x2 and 6x3 models
+auto make_cv_process(unsigned int axes){
+  double delta = 0.1; // sample time
+  arma::mat eye = arma::eye<arma::mat>(axes, axes);
+  arma::mat dynamic_matrix = arma::join_cols(
+      arma::join_rows(eye, delta * eye),
+      arma::join_rows(arma::zeros<arma::mat>(axes, axes), eye));
+  arma::mat dynamic_noise = 0.1 * arma::eye<arma::mat>(2 * axes, 2 * axes);
+  arma::mat measurement_matrix =
+      arma::join_rows(eye, arma::zeros<arma::mat>(axes, axes));
+  arma::mat measurement_noise = 0.1 * eye;
+
+  auto dynamic_cpdf = distribution::makeConditional(
+      distribution::Gaussian(2 * axes),
+      map::LinearGaussian(dynamic_matrix, dynamic_noise));
+  auto measurement_cpdf = distribution::makeConditional(
+      distribution::Gaussian(axes),
+      map::LinearGaussian(measurement_matrix, measurement_noise));
+  return process::makeHierarchical(
+      process::makeMarkov(dynamic_cpdf, distribution::Gaussian(2 * axes)),
+      process::makeMemoryless(measurement_cpdf));
+}
+
+// one predict and correct of all the tracks per iteration
+static void ssmkit_kalman_bank(benchmark::State& state) {
+  const arma::uword axes = state.range(0);
+  const arma::uword tracks = state.range(1);
+  auto bank = filter::makeKalmanBank(make_cv_process(axes), tracks);
+  bank.initialize();
+  arma::mat measurements = arma::zeros<arma::mat>(tracks, axes);
+  while (state.KeepRunning()) {
+    bank.predict();
+    bank.correct(measurements);
+  }
+  state.counters["tracks/s"] = benchmark::Counter(
+      double(state.iterations()) * tracks, benchmark::Counter::kIsRate);
+}
+BENCHMARK(ssmkit_kalman_bank)->ArgsProduct({{2, 3}, {1000, 10000, 100000}});
+
+// the same tracks as separate Kalman objects
+static void ssmkit_kalman_tracks(benchmark::State& state) {
+  const arma::uword axes = state.range(0);
+  const arma::uword tracks = state.range(1);
+  auto process = make_cv_process(axes);
+  // Kalman refers to its own process, construct in place without reallocation
+  std::vector<filter::Kalman<map::LinearGaussian, map::LinearGaussian>> filters;
+  filters.reserve(tracks);
+  for (arma::uword k = 0; k < tracks; k++) {
+    filters.emplace_back(process);
+    filters.back().initialize();
+  }
+  arma::vec measurement = arma::zeros<arma::vec>(axes);
+  while (state.KeepRunning()) {
+    for (auto &kalman : filters) {
+      kalman.predict();
+      kalman.correct(measurement);
+    }
+  }
+  state.counters["tracks/s"] = benchmark::Counter(
+      double(state.iterations()) * tracks, benchmark::Counter::kIsRate);
+}
+BENCHMARK(ssmkit_kalman_tracks)->ArgsProduct({{2, 3}, {1000, 10000}});
+
 #ifdef WITH_OpenCV
 
 #include "opencv2/video/tracking.hpp"
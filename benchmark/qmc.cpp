@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+#include "ssmkit/distribution/gaussian.hpp"
+#include "ssmkit/random/sobol.hpp"
+
+using namespace ssmkit;
+
+// moment estimation error of a 4-d Gaussian: pseudo-random vs. scrambled Sobol
+constexpr int dimension = 4;
+constexpr int repetitions = 32;
+
+arma::vec mean{1, -2, 0.5, 3};
+arma::mat covariance{
+    {2, 0.3, 0, 0}, {0.3, 1, 0.2, 0}, {0, 0.2, 0.5, 0.1}, {0, 0, 0.1, 1}};
+
+// squared error of the estimated mean and second moment of the first axis
+double error(const arma::mat &samples) {
+  arma::vec m = arma::mean(samples, 1);
+  double s = arma::accu(arma::square(samples.row(0) - mean(0))) / samples.n_cols;
+  return arma::accu(arma::square(m - mean)) +
+         std::pow(s - covariance(0, 0), 2);
+}
+
+static void prng_gaussian_moments(benchmark::State &state) {
+  distribution::Gaussian pdf(mean, covariance);
+  arma::mat samples(dimension, state.range(0));
+  double sse = 0;
+  while (state.KeepRunning()) {
+    sse = 0;
+    for (int r = 0; r < repetitions; r++) {
+      pdf.random(samples);
+      sse += error(samples);
+    }
+  }
+  state.counters["rmse"] = std::sqrt(sse / repetitions);
+}
+BENCHMARK(prng_gaussian_moments)->RangeMultiplier(4)->Range(1 << 6, 1 << 14);
+
+static void sobol_gaussian_moments(benchmark::State &state) {
+  distribution::Gaussian pdf(mean, covariance);
+  arma::mat samples(dimension, state.range(0));
+  double sse = 0;
+  while (state.KeepRunning()) {
+    sse = 0;
+    for (int r = 0; r < repetitions; r++) {
+      random::Sobol sobol(dimension); // independent scrambling per repetition
+      pdf.random(samples, sobol);
+      sse += error(samples);
+    }
+  }
+  state.counters["rmse"] = std::sqrt(sse / repetitions);
+}
+BENCHMARK(sobol_gaussian_moments)->RangeMultiplier(4)->Range(1 << 6, 1 << 14);
+
+BENCHMARK_MAIN();
@@ -11,6 +11,10 @@
 
 #include <armadillo>
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 namespace ssmkit {
 namespace distribution {
 
@@ -24,12 +28,20 @@ class Categorical {
   using TParameterVar = arma::vec;
   //! Type of the random variable \f$x\f$.
   using TValueType = unsigned int;
+  /** Number of categories from which alias method is used for sampling.
+   * Below that a linear search over the CDF is cheaper than building the table.
+   */
+  static constexpr TValueType alias_min_size = 16;
 
  private:
  //! The parameter vector \f$\mathbf{p}\f$.
  TParameterVar param_;
- //! Cumulative distribution function. 
+ //! Cumulative distribution function, only used in linear search mode.
  TParameterVar cdf_;
+ //! Probability of keeping the drawn category of alias table.
+ TParameterVar alias_prob_;
+ //! Alternative category of alias table.
+ arma::Col<TValueType> alias_;
  //! Core random number distribution.
  std::uniform_real_distribution<double> uniform_;
  //! Length of the parameter vector \f$N+1\f$.
@@ -43,15 +55,25 @@ class Categorical {
    * @pre The sum of the elements of \p parameter should be 1.0.
    */
   Categorical(TParameterVar parameters)
-      : param_(std::move(parameters)) {calcCDF(); calcMax();}
-  //! Return a random variable from the distribution.
+      : param_(std::move(parameters)) {calcMax(); calcSampler();}
+  /** Return a random variable from the distribution.
+   *
+   * Uses the alias method (Walker/Vose) with \f$O(1)\f$ cost per draw if
+   * there are at least #alias_min_size categories, otherwise a linear search
+   * over the CDF.
+   */
   TValueType random() {
-    double rv = uniform_(random::Generator::get().getGenerator());
-    for (TValueType i = 0; i < max_; ++i)
-      if (rv < cdf_(i))
-        return i;
-
-    return 0; // this line never get reached
+    return draw(random::Generator::get().getGenerator());
+  }
+  /** Return \p n random variables from the distribution.
+   * @param n Number of samples.
+   * @return Vector of \p n samples.
+   */
+  arma::uvec random_n(const size_t &n) {
+    auto &gen = random::Generator::get().getGenerator();
+    arma::uvec out(n);
+    out.imbue([this, &gen]() { return draw(gen); });
+    return out;
   }
   //! Return likelihood of the given random variable
   double likelihood(const TValueType &rv) {
@@ -64,14 +86,63 @@ class Categorical {
    */
   Categorical &parameterize(const TParameterVar & param){
     param_ = param;
-    calcCDF();
     calcMax();
+    calcSampler();
     return *this;
   }
 
   private:
    void calcCDF() { cdf_ = arma::cumsum(param_); }
    void calcMax() { max_ = param_.n_rows; }
+   //! Builds the data needed by the sampling method fitting to \f$N+1\f$.
+   void calcSampler() {
+     if (max_ < alias_min_size)
+       calcCDF();
+     else
+       calcAlias();
+   }
+   /** Builds alias table using Vose's method.
+    *
+    * M. D. Vose, "A linear algorithm for generating random numbers with a
+    * given distribution," IEEE Transactions on Software Engineering, vol. 17,
+    * no. 9, pp. 972-975, 1991.
+    */
+   void calcAlias() {
+     alias_prob_ = param_ * (max_ / arma::accu(param_));
+     alias_.set_size(max_);
+     std::vector<TValueType> small, large;
+     small.reserve(max_);
+     large.reserve(max_);
+     for (TValueType i = 0; i < max_; ++i)
+       (alias_prob_(i) < 1.0 ? small : large).push_back(i);
+
+     while (!small.empty() && !large.empty()) {
+       TValueType s = small.back();
+       TValueType l = large.back();
+       small.pop_back();
+       large.pop_back();
+       alias_(s) = l;
+       alias_prob_(l) += alias_prob_(s) - 1.0;
+       (alias_prob_(l) < 1.0 ? small : large).push_back(l);
+     }
+     // the rest are one up to round-off error
+     for (auto i : large) { alias_prob_(i) = 1.0; alias_(i) = i; }
+     for (auto i : small) { alias_prob_(i) = 1.0; alias_(i) = i; }
+   }
+   //! Draws one sample with the sampling method fitting to \f$N+1\f$.
+   template <class TGenerator>
+   TValueType draw(TGenerator &gen) {
+     double rv = uniform_(gen);
+     if (max_ < alias_min_size) {
+       for (TValueType i = 0; i < max_; ++i)
+         if (rv < cdf_(i))
+           return i;
+       return 0; // this line never get reached
+     }
+     double u = rv * max_;
+     TValueType i = std::min(static_cast<TValueType>(u), max_ - 1);
+     return (u - i) < alias_prob_(i) ? i : alias_(i);
+   }
 };
 
 } // namespace ssmkit
@@ -7,7 +7,10 @@
 #ifndef SSMPACK_DISTRIBUTION_PARAMETRIC_CONDITIONAL_HPP
 #define SSMPACK_DISTRIBUTION_PARAMETRIC_CONDITIONAL_HPP
 
+#include <armadillo>
+
 #include <algorithm>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -15,6 +18,60 @@
 namespace ssmkit {
 namespace distribution {
 
+/// @cond DEV
+namespace detail {
+template <class... T>
+struct Void {
+  using type = void;
+};
+/* true if the parameter map provides a batch(const arma::mat &, args...)
+ * method that returns the parameters of a block of conditions at once.
+ */
+template <class TParamMap, class TArgs, class = void>
+struct HasBatchMap : std::false_type {};
+
+template <class TParamMap, class... Args>
+struct HasBatchMap<
+    TParamMap, std::tuple<Args...>,
+    typename Void<decltype(std::declval<const TParamMap &>().batch(
+        std::declval<const arma::mat &>(),
+        std::declval<const Args &>()...))>::type> : std::true_type {};
+
+/* true if the parameter map provides mean(arma::vec &, const arma::vec &,
+ * args...) that writes the mean into a given vector, see
+ * map::LinearGaussian::mean
+ */
+template <class TParamMap, class TArgs, class = void>
+struct HasMeanMap : std::false_type {};
+
+template <class TParamMap, class... Args>
+struct HasMeanMap<
+    TParamMap, std::tuple<Args...>,
+    typename Void<decltype(std::declval<const TParamMap &>().mean(
+        std::declval<arma::vec &>(), std::declval<const arma::vec &>(),
+        std::declval<const Args &>()...))>::type> : std::true_type {};
+
+// the mean of a map into out, without a temporary if the map allows it
+template <class TParamMap, class... Args>
+void mapMean(std::true_type, arma::vec &out, const TParamMap &map,
+             const arma::vec &x, const Args &... args) {
+  map.mean(out, x, args...);
+}
+
+template <class TParamMap, class... Args>
+void mapMean(std::false_type, arma::vec &out, const TParamMap &map,
+             const arma::vec &x, const Args &... args) {
+  out = std::get<0>(map(x, args...));
+}
+
+template <class TParamMap, class... Args>
+void mapMean(arma::vec &out, const TParamMap &map, const arma::vec &x,
+             const Args &... args) {
+  mapMean(HasMeanMap<TParamMap, std::tuple<Args...>>(), out, map, x, args...);
+}
+} // namespace detail
+/// @endcond
+
 /** Conditional distribution function
  *
  * Let \f$x \in X\f$ and \f$(y_0, \cdots, y_N) \in \{Y_0, \cdots, Y_n\}  \f$, the class defines a conditional distribution of
@@ -68,6 +125,39 @@ class Conditional {
     return pdf_.likelihood(rv);
   }
 
+  /** Sample from distribution for a block of conditions
+   *
+   * If the parameter map provides a \a batch method (e.g. map::LinearGaussian)
+   * the parameters of all the columns are computed at once, otherwise the
+   * columns are sampled one by one.
+   *
+   * @param conditions Condition variables \f$y_0\f$, one per column.
+   * @param args... Condition variables \f$y_1, \cdots, y_N\f$ shared by all the columns.
+   * @return random variables \f$x\f$, one per column.
+   */
+  template <typename... Args>
+  arma::mat random(const arma::mat &conditions, const Args &... args) {
+    arma::mat out;
+    randomBatch(detail::HasBatchMap<TParamMap, std::tuple<Args...>>(), out,
+                conditions, args...);
+    return out;
+  }
+
+  /** Calculate the likelihood of a block of random variables
+   *
+   * @param rvs random variables \f$x\f$, one per column, or one column which
+   * is evaluated against every condition.
+   * @param conditions Condition variables \f$y_0\f$, one per column.
+   * @param args... Condition variables \f$y_1, \cdots, y_N\f$ shared by all the columns.
+   * @return likelihood \f$p(x|y_0, \cdots, y_N)\f$ of every column.
+   */
+  template <typename... Args>
+  arma::vec likelihood(const arma::mat &rvs, const arma::mat &conditions,
+                       const Args &... args) {
+    return likelihoodBatch(detail::HasBatchMap<TParamMap, std::tuple<Args...>>(),
+                           rvs, conditions, args...);
+  }
+
   //! Returns a reference to \f$\mathcal{F}(\theta)\f$.
   const TPDF & getPDF() const {return pdf_;}
   //! Returns a reference to \f$g(.)\f$.
@@ -77,6 +167,45 @@ class Conditional {
   TPDF pdf_;
   //! \f$g(.)\f$.
   TParamMap map_;
+
+ private:
+  //! Block sampling using the batch method of the map.
+  template <typename... Args>
+  void randomBatch(std::true_type, arma::mat &out, const arma::mat &conditions,
+                   const Args &... args) {
+    pdf_.random(out, map_.batch(conditions, args...));
+  }
+  //! Block sampling column by column.
+  template <typename... Args>
+  void randomBatch(std::false_type, arma::mat &out, const arma::mat &conditions,
+                   const Args &... args) {
+    for (arma::uword i = 0; i < conditions.n_cols; ++i) {
+      pdf_.parameterize(map_(conditions.col(i), args...));
+      const arma::vec rv = pdf_.random();
+      if (i == 0)
+        out.set_size(rv.n_rows, conditions.n_cols);
+      out.col(i) = rv;
+    }
+  }
+  //! Block likelihood using the batch method of the map.
+  template <typename... Args>
+  arma::vec likelihoodBatch(std::true_type, const arma::mat &rvs,
+                            const arma::mat &conditions, const Args &... args) {
+    return arma::exp(
+        pdf_.logLikelihoodBatch(rvs, map_.batch(conditions, args...)));
+  }
+  //! Block likelihood column by column.
+  template <typename... Args>
+  arma::vec likelihoodBatch(std::false_type, const arma::mat &rvs,
+                            const arma::mat &conditions, const Args &... args) {
+    arma::vec lik(conditions.n_cols);
+    for (arma::uword i = 0; i < conditions.n_cols; ++i) {
+      pdf_.parameterize(map_(conditions.col(i), args...));
+      const arma::vec rv = rvs.col(rvs.n_cols == 1 ? 0 : i);
+      lik(i) = pdf_.likelihood(rv);
+    }
+    return lik;
+  }
 };
 
 /** Convenient builder that returns a conditional distribution object.
@@ -8,10 +8,16 @@
 #define SSMPACK_DISTRIBUTION_GAUSSIAN_HPP
 
 #include "ssmkit/random/generator.hpp"
+#include "ssmkit/random/normal.hpp"
 
 #include <armadillo>
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
 
 namespace ssmkit {
 namespace distribution {
@@ -26,6 +32,10 @@ class Gaussian {
  public:
   //! Data type of the parameter variable \f$ \theta = \{\mu, \Sigma\} \f$.
   using TParameterVAR = std::tuple<arma::vec, arma::mat>;
+  /** Data type of the parameter of a block of Gaussians sharing covariance
+   * \f$ \{[\mu_1, \cdots, \mu_N], \Sigma\} \f$.
+   */
+  using TBatchParameterVAR = std::tuple<arma::mat, arma::mat>;
 
  private:
   //! mean vector \f$\mu\f$.
@@ -33,32 +43,60 @@ class Gaussian {
   //! covariance matrix \f$\Sigma\f$.
   arma::mat covariance_;
   /** a normal distribution random generator \f$\mathcal{N}(0,1)\f$ */
-  std::normal_distribution<double> normal_;
+  random::Normal normal_;
   //! \f$\pi\f$
   static constexpr double pi = 3.1415926535897;
-  //! inverse of covariance matrix \f$\Sigma^{-1}\f$.
-  arma::mat inv_cov_;
-  //! partitioning function \f$\frac{1}{(2\pi)^{D/2}\sqrt{|\Sigma|}}\f$.
-  double part_;
+  /** logarithm of partitioning function
+   * \f$-\frac{D}{2}\log(2\pi)-\frac{1}{2}\log|\Sigma|\f$.
+   */
+  double log_part_;
   //! Cholesky decomposition of covariance matrix, i.e. \f$L\f$ such that  \f$LL^T=\Sigma\f$.
   arma::mat chol_dec_;
   //! Dimension \f$D\f$
   int dim_;
+  //! Buffer of standard normal draws reused by random(arma::mat &).
+  arma::mat noise_;
 
  private:
   /**
    * Calculates useful constant values for avoiding recalculation for every 
    * call to likelihood().
+   *
+   * Only the Cholesky factor is computed, the log-determinant is taken from
+   * its diagonal \f$\log|\Sigma| = 2\sum_i\log L_{ii}\f$.
    */
   void calcDistConstants() {
-    dim_ = mean_.n_rows;
-    inv_cov_ = arma::inv(covariance_);
-    // calculate partition function
-    double det_cov = arma::det(covariance_);
-    double den_pi = 1 / std::sqrt(std::pow(2 * pi, dim_));
-    part_ = den_pi * (1 / std::sqrt(det_cov));
+    dim_ = covariance_.n_rows;
     // Cholesky decomposition
     chol_dec_ = arma::chol(covariance_, "lower");
+    // calculate log of partition function
+    log_part_ = -0.5 * dim_ * std::log(2 * pi) -
+                arma::accu(arma::log(chol_dec_.diag()));
+  }
+
+  /** Checks if \p covariance is element-wise identical to the current one.
+   * This costs \f$O(D^2)\f$ against \f$O(D^3)\f$ of calcDistConstants().
+   */
+  bool isCovariance(const arma::mat &covariance) const {
+    return covariance.n_rows == covariance_.n_rows &&
+           covariance.n_cols == covariance_.n_cols &&
+           std::equal(covariance.begin(), covariance.end(),
+                      covariance_.begin());
+  }
+
+  //! Changes the covariance, the factorization is kept if it is unchanged.
+  void setCovariance(const arma::mat &covariance) {
+    if (!isCovariance(covariance)) {
+      covariance_ = covariance;
+      calcDistConstants();
+    }
+  }
+
+  //! Fills noise_ with \f$D \times n\f$ standard normal draws.
+  void fillNoise(const arma::uword &n) {
+    auto &gen = random::Generator::get().getGenerator();
+    noise_.set_size(dim_, n);
+    normal_.fill(gen, noise_.memptr(), noise_.n_elem);
   }
 
  public:
@@ -86,10 +124,77 @@ class Gaussian {
    * @return The random vector \f$\mathbf{x}\f$
    */
   arma::vec random() {
-    arma::vec rnd(dim_); // how much overload the vector construction has?
-    rnd.imbue(
-        [&]() { return normal_(random::Generator::get().getGenerator()); });
-    return mean_ + chol_dec_ * rnd;
+    arma::vec rnd(dim_);
+    normal_.fill(random::Generator::get().getGenerator(), rnd.memptr(), dim_);
+    return mean_ + arma::trimatl(chol_dec_) * rnd;
+  }
+
+  /** Fills every column of \p out with a random variable from the distribution.
+   *
+   * The standard normal draws of the whole block are generated in one pass
+   * and coloured by one matrix product \f$X = \mu\mathbf{1}^T + LZ\f$.
+   *
+   * @param[in,out] out Matrix whose \p n_cols determines the number of
+   * samples, it is resized to \f$D\f$ rows.
+   */
+  void random(arma::mat &out) {
+    fillNoise(out.n_cols);
+    out = arma::trimatl(chol_dec_) * noise_;
+    out.each_col() += mean_;
+  }
+
+  /** Fills every column of \p out with a sample drawn from \p source.
+   *
+   * The standard normal points of \p source, e.g. random::Sobol for
+   * quasi-Monte Carlo, are coloured as \f$X = \mu\mathbf{1}^T + LZ\f$.
+   *
+   * @param[in,out] out Matrix whose \p n_cols determines the number of
+   * samples, it is resized to \f$D\f$ rows.
+   * @param source Sample source providing dimension() and
+   * normal(double *out, size_t n) that writes \p n points of that dimension.
+   * @throw std::invalid_argument if the dimension of \p source is not
+   * \f$D\f$.
+   */
+  template <class TSource,
+            class = decltype(std::declval<TSource &>().normal(
+                std::declval<double *>(), std::size_t())),
+            class = decltype(std::declval<const TSource &>().dimension())>
+  void random(arma::mat &out, TSource &source) {
+    if (source.dimension() != static_cast<arma::uword>(dim_))
+      throw std::invalid_argument(
+          "Gaussian::random(): dimension of the source is not that of the "
+          "distribution");
+    noise_.set_size(dim_, out.n_cols);
+    source.normal(noise_.memptr(), out.n_cols);
+    out = arma::trimatl(chol_dec_) * noise_;
+    out.each_col() += mean_;
+  }
+
+  /** Draws one random variable per column of the mean block.
+   * \f[ \mathbf{x}_i \sim \mathcal{N}(\mu_i, \Sigma) \f]
+   * The covariance of the distribution is changed to \f$\Sigma\f$, the mean
+   * vector is not touched.
+   * @param[out] out \f$[\mathbf{x}_1, \cdots, \mathbf{x}_N]\f$.
+   * @param parameters Tuple of the means (one per column) and the shared
+   * covariance, e.g. TBatchParameterVAR or map::LinearGaussian::TBatchParameter.
+   */
+  template <class TMeans, class TCovariance>
+  void random(arma::mat &out,
+              const std::tuple<TMeans, TCovariance> &parameters) {
+    const arma::mat &means = std::get<0>(parameters);
+    setCovariance(std::get<1>(parameters));
+    fillNoise(means.n_cols);
+    out = arma::trimatl(chol_dec_) * noise_ + means;
+  }
+
+  /** Returns \p n random variables from the distribution.
+   * @param n Number of samples.
+   * @return \f$D \times n\f$ matrix with one sample per column.
+   */
+  arma::mat random_n(const size_t &n) {
+    arma::mat out(dim_, n);
+    random(out);
+    return out;
   }
 
   /** Returns the likelihood of a given random variable.
@@ -99,22 +204,90 @@ class Gaussian {
    * @return \f$p(\mathbf{x})\f$.
    */
   double likelihood(const arma::vec &rv) const {
-    const auto diff = rv - mean_;
-    const arma::vec tmp = diff.t() * inv_cov_ * diff;
-    const double expt = -tmp(0) / 2;
-    return part_ * std::exp(expt);
+    return std::exp(logLikelihood(rv));
+  }
+
+  /** Returns the log-likelihood of a given random variable.
+   * \f[\log p(\mathbf{x}) = -\frac{D}{2}\log(2\pi)-\frac{1}{2}\log|\Sigma|
+   * -\frac{1}{2}\mathbf{z}^T\mathbf{z}, \quad L\mathbf{z} = \mathbf{x}-\mu\f]
+   * The Mahalanobis term is computed by a triangular solve with the Cholesky
+   * factor, thus it stays finite when \f$|\Sigma|\f$ under/overflows.
+   * @param rv The random variable \f$\mathbf{x}\f$ for which log-likelihood is calculated.
+   * @return \f$\log p(\mathbf{x})\f$.
+   */
+  double logLikelihood(const arma::vec &rv) const {
+    const arma::vec z = arma::solve(arma::trimatl(chol_dec_), rv - mean_);
+    return log_part_ - arma::dot(z, z) / 2;
+  }
+
+  /** Returns the likelihood of every column of \p points.
+   * @param points Random variables \f$[\mathbf{x}_1, \cdots, \mathbf{x}_N]\f$, one per column.
+   * @return \f$[p(\mathbf{x}_1), \cdots, p(\mathbf{x}_N)]^T\f$.
+   */
+  arma::vec likelihoodBatch(const arma::mat &points) const {
+    return arma::exp(logLikelihoodBatch(points));
+  }
+
+  /** Returns the log-likelihood of every column of \p points.
+   *
+   * All the columns are whitened by one triangular solve
+   * \f$LZ = [\mathbf{x}_1-\mu, \cdots, \mathbf{x}_N-\mu]\f$ instead of
+   * \f$N\f$ matrix-vector solves.
+   *
+   * @param points Random variables \f$[\mathbf{x}_1, \cdots, \mathbf{x}_N]\f$, one per column.
+   * @return \f$[\log p(\mathbf{x}_1), \cdots, \log p(\mathbf{x}_N)]^T\f$.
+   */
+  arma::vec logLikelihoodBatch(const arma::mat &points) const {
+    const arma::mat z =
+        arma::solve(arma::trimatl(chol_dec_), points.each_col() - mean_);
+    return log_part_ - arma::sum(arma::square(z), 0).t() / 2;
+  }
+
+  /** Returns the log-likelihood of points under a block of Gaussians.
+   * \f[[\log\mathcal{N}(\mathbf{x}_1|\mu_1, \Sigma), \cdots,
+   * \log\mathcal{N}(\mathbf{x}_N|\mu_N, \Sigma)]^T\f]
+   * The covariance of the distribution is changed to \f$\Sigma\f$, the mean
+   * vector is not touched.
+   * @param points \f$[\mathbf{x}_1, \cdots, \mathbf{x}_N]\f$, or one column
+   * which is evaluated against every mean.
+   * @param parameters Tuple of the means (one per column) and the shared
+   * covariance, e.g. TBatchParameterVAR or map::LinearGaussian::TBatchParameter.
+   */
+  template <class TMeans, class TCovariance>
+  arma::vec
+  logLikelihoodBatch(const arma::mat &points,
+                     const std::tuple<TMeans, TCovariance> &parameters) {
+    const arma::mat &means = std::get<0>(parameters);
+    setCovariance(std::get<1>(parameters));
+    arma::mat diff;
+    if (points.n_cols == 1) {
+      diff = -means;
+      diff.each_col() += points.col(0);
+    } else {
+      diff = points - means;
+    }
+    const arma::mat z = arma::solve(arma::trimatl(chol_dec_), diff);
+    return log_part_ - arma::sum(arma::square(z), 0).t() / 2;
   }
 
   /** Changes the mean and covariance of the distribution with the given
    * parameters.
-   * @param parameters A tuple containing mean and covariance.
+   * @param parameters A tuple containing mean and covariance, e.g.
+   * TParameterVAR or map::LinearGaussian::TParameter whose covariance is a
+   * reference to the covariance of the map.
    * @return Reference to the current instance.
    */
-  Gaussian &parameterize(const TParameterVAR &parameters) {
+  template <class TMean, class TCovariance>
+  Gaussian &parameterize(const std::tuple<TMean, TCovariance> &parameters) {
     return parameterize(std::get<0>(parameters), std::get<1>(parameters));
   }
 
   /** Changes the mean and covariance of the distribution with the given values.
+   *
+   * If \p covariance is equal to the current covariance only the mean is
+   * updated and the cached Cholesky factor is kept, e.g. when the parameters
+   * come from map::LinearGaussian only the mean changes between calls.
+   *
    * @param mean The mean vector.
    * @param covariance The covariance matrix.
    * @return Reference to the current instance.
@@ -122,8 +295,7 @@ class Gaussian {
   Gaussian &parameterize(const arma::vec &mean,
                          const arma::mat &covariance) {
     mean_ = mean;
-    covariance_ = covariance;
-    calcDistConstants();
+    setCovariance(covariance);
     return (*this);
   }
   //! Returns the mean vector 
@@ -0,0 +1,225 @@
+/**
+ * @file fixed_kalman.hpp
+ * @author Vahid Bastani
+ *
+ * Kalman filter with compile-time dimensions.
+ */
+#ifndef SSMPACK_FILTER_FIXED_KALMAN_HPP
+#define SSMPACK_FILTER_FIXED_KALMAN_HPP
+
+#include "ssmkit/distribution/gaussian.hpp"
+#include "ssmkit/distribution/conditional.hpp"
+#include "ssmkit/process/markov.hpp"
+#include "ssmkit/process/memoryless.hpp"
+#include "ssmkit/process/hierarchical.hpp"
+#include "ssmkit/filter/recursive_bayesian_base.hpp"
+#include <armadillo>
+
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+
+namespace ssmkit {
+namespace filter {
+
+using process::Hierarchical;
+using process::Markov;
+using process::Memoryless;
+using distribution::Conditional;
+using distribution::Gaussian;
+
+/** Kalman filter with compile-time state and measurement dimensions.
+ *
+ * For small models, e.g. 4 states and 2 measurements, the time of
+ * filter::Kalman goes to heap allocation of temporaries and BLAS dispatch.
+ * This filter keeps everything in fixed size matrices and evaluates the
+ * equations with loops of compile-time length which the compiler unrolls,
+ * so a step does not allocate nor call BLAS. The innovation covariance is
+ * factorized as \f$\mathbf{S} = \mathbf{L}\mathbf{L}^T\f$ and with
+ * \f$\mathbf{W} = \mathbf{L}^{-1}\mathbf{H}\mathbf{P}\f$ the correction is
+ * \f{equation}{\hat{\mathbf{x}} \leftarrow \hat{\mathbf{x}} +
+ * \mathbf{W}^T\mathbf{L}^{-1}\tilde{\mathbf{z}}, \quad
+ * \mathbf{P} \leftarrow \mathbf{P} - \mathbf{W}^T\mathbf{W}\f}
+ *
+ * The maps should be linear without controls, \f$\mathbf{F}, \mathbf{Q},
+ * \mathbf{H}, \mathbf{R}\f$ are copied from their \a transfer and
+ * \a covariance.
+ *
+ * @tparam N State dimension.
+ * @tparam M Measurement dimension.
+ */
+template <arma::uword N, arma::uword M, class STA_MAP, class OBS_MAP>
+class FixedKalman
+    : public RecursiveBayesianBase<FixedKalman<N, M, STA_MAP, OBS_MAP>> {
+  static_assert(N > 0 && M > 0, "dimensions should be positive");
+
+ public:
+  //! Type of process object
+  using TProcess =
+      Hierarchical<Markov<Gaussian, STA_MAP, Gaussian>,
+                   Memoryless<Gaussian, OBS_MAP>>;
+  //! Type of the state vector
+  using TStateVec = arma::vec::fixed<N>;
+  //! Type of the state covariance
+  using TStateCov = arma::mat::fixed<N, N>;
+  //! Type of the measurement vector
+  using TMeasurement = arma::vec::fixed<M>;
+  //! Type of the posterior state \f$(\hat{\mathbf{x}}, \hat{\mathbf{P}})\f$
+  using TCompeleteState = std::tuple<TStateVec, TStateCov>;
+
+ private:
+  //! The process object
+  TProcess process_;
+  //! The state transition matrix \f$\mathbf{F}\f$
+  TStateCov dyn_mat_;
+  //! The covariance of dynamic noise \f$\mathbf{Q}\f$
+  TStateCov dyn_cov_;
+  //! The measurement matrix \f$\mathbf{H}\f$
+  arma::mat::fixed<M, N> mes_mat_;
+  //! The covariance of measurement noise \f$\mathbf{R}\f$
+  arma::mat::fixed<M, M> mes_cov_;
+  //! The state vector
+  TStateVec state_vec_;
+  //! The state covariance
+  TStateCov state_cov_;
+  // workspace: F P or H P, and the factor of the innovation covariance
+  TStateCov fp_;
+  arma::mat::fixed<M, N> hp_;
+  arma::mat::fixed<M, M> chol_;
+  TMeasurement inovation_;
+
+ public:
+  /** Construct a fixed dimension Kalman filter
+   *
+   * Construct a Kalman filter with parameters taken from \p process argument.
+   */
+  FixedKalman(const TProcess &process)
+      : process_(process),
+        dyn_mat_(process_.template getProcess<0>().getCPDF().getParamMap()
+                     .transfer),
+        dyn_cov_(process_.template getProcess<0>().getCPDF().getParamMap()
+                     .covariance),
+        mes_mat_(process_.template getProcess<1>().getCPDF().getParamMap()
+                     .transfer),
+        mes_cov_(process_.template getProcess<1>().getCPDF().getParamMap()
+                     .covariance) {}
+
+  /** Prediction
+   * \f{equation}{\hat{\mathbf{x}}_{t|t-1} = \mathbf{F}\hat{\mathbf{x}}_{t-1|t-1}\f}
+   * \f{equation}{\mathbf{P}_{t|t-1} = \mathbf{F}\mathbf{P}_{t-1|t-1}\mathbf{F}^T+\mathbf{Q}\f}
+   */
+  void predict() {
+    TStateVec x;
+    for (arma::uword i = 0; i < N; i++) {
+      double sum = 0;
+      for (arma::uword k = 0; k < N; k++)
+        sum += dyn_mat_.at(i, k) * state_vec_.at(k);
+      x.at(i) = sum;
+    }
+    state_vec_ = x;
+
+    for (arma::uword i = 0; i < N; i++)
+      for (arma::uword l = 0; l < N; l++) {
+        double sum = 0;
+        for (arma::uword k = 0; k < N; k++)
+          sum += dyn_mat_.at(i, k) * state_cov_.at(k, l);
+        fp_.at(i, l) = sum;
+      }
+    for (arma::uword j = 0; j < N; j++)
+      for (arma::uword i = 0; i <= j; i++) {
+        double sum = dyn_cov_.at(i, j);
+        for (arma::uword l = 0; l < N; l++)
+          sum += fp_.at(i, l) * dyn_mat_.at(j, l);
+        state_cov_.at(i, j) = state_cov_.at(j, i) = sum;
+      }
+  }
+
+  /** Correction
+   *
+   * @param measurement Measurement vector \f$\mathbf{z}_t\f$.
+   * @return Estimated state \f$(\hat{\mathbf{x}}_{t|t}, \mathbf{P}_{t|t})\f$
+   * @throw std::runtime_error if the innovation covariance is not positive
+   * definite, the filter then keeps the predicted state.
+   */
+  TCompeleteState correct(const TMeasurement &measurement) {
+    // innovation and H P
+    for (arma::uword r = 0; r < M; r++) {
+      double sum = measurement.at(r);
+      for (arma::uword k = 0; k < N; k++)
+        sum -= mes_mat_.at(r, k) * state_vec_.at(k);
+      inovation_.at(r) = sum;
+      for (arma::uword c = 0; c < N; c++) {
+        double hp = 0;
+        for (arma::uword k = 0; k < N; k++)
+          hp += mes_mat_.at(r, k) * state_cov_.at(k, c);
+        hp_.at(r, c) = hp;
+      }
+    }
+
+    // lower Cholesky factor of S = H P H^T + R
+    for (arma::uword j = 0; j < M; j++) {
+      for (arma::uword i = j; i < M; i++) {
+        double sum = mes_cov_.at(i, j);
+        for (arma::uword c = 0; c < N; c++)
+          sum += hp_.at(i, c) * mes_mat_.at(j, c);
+        for (arma::uword k = 0; k < j; k++)
+          sum -= chol_.at(i, k) * chol_.at(j, k);
+        if (i == j && !(sum > 0))
+          throw std::runtime_error("FixedKalman::correct(): innovation "
+                                   "covariance is not positive definite");
+        chol_.at(i, j) = i == j ? std::sqrt(sum) : sum / chol_.at(j, j);
+      }
+    }
+
+    // W = L^-1 H P and L^-1 z by forward substitution, in place
+    for (arma::uword r = 0; r < M; r++) {
+      const double inv_diag = 1 / chol_.at(r, r);
+      for (arma::uword k = 0; k < r; k++) {
+        for (arma::uword c = 0; c < N; c++)
+          hp_.at(r, c) -= chol_.at(r, k) * hp_.at(k, c);
+        inovation_.at(r) -= chol_.at(r, k) * inovation_.at(k);
+      }
+      for (arma::uword c = 0; c < N; c++)
+        hp_.at(r, c) *= inv_diag;
+      inovation_.at(r) *= inv_diag;
+    }
+
+    for (arma::uword j = 0; j < N; j++) {
+      for (arma::uword r = 0; r < M; r++)
+        state_vec_.at(j) += hp_.at(r, j) * inovation_.at(r);
+      for (arma::uword i = 0; i <= j; i++) {
+        double sum = state_cov_.at(i, j);
+        for (arma::uword r = 0; r < M; r++)
+          sum -= hp_.at(r, i) * hp_.at(r, j);
+        state_cov_.at(i, j) = state_cov_.at(j, i) = sum;
+      }
+    }
+    return std::make_tuple(state_vec_, state_cov_);
+  }
+
+  /** Initialization
+   *
+   * @return Initial state \f$(\hat{\mathbf{x}}_{0|0}, \mathbf{P}_{0|0})\f$
+   */
+  TCompeleteState initialize() {
+    state_vec_ = process_.template getProcess<0>().getInitialPDF().getMean();
+    state_cov_ =
+        process_.template getProcess<0>().getInitialPDF().getCovariance();
+    return std::make_tuple(state_vec_, state_cov_);
+  }
+};
+
+/** Builds a FixedKalman, the dimensions are given explicitly, e.g.
+ * makeFixedKalman<4, 2>(process).
+ */
+template <arma::uword N, arma::uword M, class STA_MAP, class OBS_MAP>
+FixedKalman<N, M, STA_MAP, OBS_MAP> makeFixedKalman(
+    Hierarchical<Markov<Gaussian, STA_MAP, Gaussian>,
+                 Memoryless<Gaussian, OBS_MAP>> process) {
+  return FixedKalman<N, M, STA_MAP, OBS_MAP>(process);
+}
+
+} // namespace filter
+} // namespace ssmkit
+
+#endif // SSMPACK_FILTER_FIXED_KALMAN_HPP
@@ -0,0 +1,219 @@
+/**
+ * @file gain_schedule.hpp
+ * @author Vahid Bastani
+ *
+ * Precomputed covariance and gain sequence of a Kalman filter.
+ */
+#ifndef SSMPACK_FILTER_GAIN_SCHEDULE_HPP
+#define SSMPACK_FILTER_GAIN_SCHEDULE_HPP
+
+#include "ssmkit/distribution/gaussian.hpp"
+#include "ssmkit/distribution/conditional.hpp"
+#include "ssmkit/process/markov.hpp"
+#include "ssmkit/process/memoryless.hpp"
+#include "ssmkit/process/hierarchical.hpp"
+#include <armadillo>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ssmkit {
+namespace filter {
+
+/// @cond DEV
+namespace detail {
+/* true if the map is made of identical independent blocks and provides
+ * block_transfer, block_covariance and blocks, see map::BlockLinearGaussian
+ */
+template <class TMap, class = void>
+struct IsBlockMap : std::false_type {};
+
+template <class TMap>
+struct IsBlockMap<TMap, typename distribution::detail::Void<
+                            decltype(std::declval<const TMap &>().blocks)>::type>
+    : std::true_type {};
+
+// dense F and Q (or H and R), for the computations done once
+template <class TMap>
+arma::mat denseTransfer(const TMap &map, std::false_type) {
+  return arma::mat(map.transfer);
+}
+
+template <class TMap>
+arma::mat denseTransfer(const TMap &map, std::true_type) {
+  return arma::kron(arma::eye<arma::mat>(map.blocks, map.blocks),
+                    map.block_transfer);
+}
+
+template <class TMap>
+arma::mat denseTransfer(const TMap &map) {
+  return denseTransfer(map, IsBlockMap<TMap>());
+}
+
+template <class TMap>
+arma::mat denseCovariance(const TMap &map, std::false_type) {
+  return arma::mat(map.covariance);
+}
+
+template <class TMap>
+arma::mat denseCovariance(const TMap &map, std::true_type) {
+  return arma::kron(arma::eye<arma::mat>(map.blocks, map.blocks),
+                    map.block_covariance);
+}
+
+template <class TMap>
+arma::mat denseCovariance(const TMap &map) {
+  return denseCovariance(map, IsBlockMap<TMap>());
+}
+} // namespace detail
+/// @endcond
+
+/** Covariance and gain sequence of a time-invariant Kalman filter.
+ *
+ * For a linear Gaussian model with constant \f$\mathbf{F}, \mathbf{Q},
+ * \mathbf{H}, \mathbf{R}\f$ the sequence \f$\mathbf{P}_{t|t-1},
+ * \mathbf{K}_t, \mathbf{P}_{t|t}\f$ depends only on \f$\mathbf{P}_{0|0}\f$
+ * and not on the measurements. The schedule runs this recursion once, then
+ * any number of Kalman filters with the same model and initial covariance
+ * can share it (see Kalman::setGainSchedule) and only update their means.
+ *
+ * The recursion stops when the corrected covariance converges or after a
+ * maximum number of steps; later steps use the last entry, which is the
+ * steady state only if isConverged().
+ */
+class GainSchedule {
+ private:
+  //! The predicted covariances \f$\mathbf{P}_{t|t-1}\f$
+  std::vector<arma::mat> p_covs_;
+  //! The gains \f$\mathbf{K}_t\f$
+  std::vector<arma::mat> gains_;
+  //! The corrected covariances \f$\mathbf{P}_{t|t}\f$
+  std::vector<arma::mat> covs_;
+  //! The initial covariance \f$\mathbf{P}_{0|0}\f$
+  arma::mat initial_cov_;
+  //! True if the recursion has converged
+  bool converged_ = false;
+
+  std::size_t index(std::size_t t) const {
+    return std::min(t, gains_.size() - 1);
+  }
+
+  // one step of the recursion from the corrected covariance cov
+  static void recursion(const arma::mat &dyn_mat, const arma::mat &dyn_cov,
+                        const arma::mat &mes_mat, const arma::mat &mes_cov,
+                        const arma::mat &cov, arma::mat &p_cov,
+                        arma::mat &gain, arma::mat &next_cov) {
+    p_cov = dyn_mat * cov * dyn_mat.t() + dyn_cov;
+    arma::mat hp = mes_mat * p_cov;
+    gain = hp.t() * arma::inv_sympd(hp * mes_mat.t() + mes_cov);
+    next_cov = p_cov - gain * hp;
+  }
+
+ public:
+  /** Runs the covariance recursion.
+   * @param dyn_mat The state transition matrix \f$\mathbf{F}\f$.
+   * @param dyn_cov The covariance of dynamic noise \f$\mathbf{Q}\f$.
+   * @param mes_mat The measurement matrix \f$\mathbf{H}\f$.
+   * @param mes_cov The covariance of measurement noise \f$\mathbf{R}\f$.
+   * @param initial_cov The initial covariance \f$\mathbf{P}_{0|0}\f$.
+   * @param max_steps Maximum length of the schedule.
+   * @param tolerance Maximum absolute difference of two consecutive
+   * corrected covariances at convergence.
+   */
+  GainSchedule(const arma::mat &dyn_mat, const arma::mat &dyn_cov,
+               const arma::mat &mes_mat, const arma::mat &mes_cov,
+               const arma::mat &initial_cov, std::size_t max_steps = 1000,
+               double tolerance = 1e-12)
+      : initial_cov_(initial_cov) {
+    arma::mat cov = initial_cov;
+    for (std::size_t t = 0; t < std::max<std::size_t>(max_steps, 1); t++) {
+      arma::mat p_cov, gain, next_cov;
+      recursion(dyn_mat, dyn_cov, mes_mat, mes_cov, cov, p_cov, gain,
+                next_cov);
+
+      converged_ = t > 0 && arma::approx_equal(next_cov, cov, "absdiff",
+                                                tolerance);
+      p_covs_.push_back(std::move(p_cov));
+      gains_.push_back(std::move(gain));
+      covs_.push_back(next_cov);
+      cov = std::move(next_cov);
+      if (converged_)
+        break;
+    }
+  }
+
+  //! Returns the initial covariance \f$\mathbf{P}_{0|0}\f$
+  const arma::mat &getInitialCovariance() const { return initial_cov_; }
+  //! Returns \f$\mathbf{P}_{t|t-1}\f$ of step \p t, the first step is 1
+  const arma::mat &getPredictedCovariance(std::size_t t) const {
+    return p_covs_[index(t - 1)];
+  }
+  //! Returns \f$\mathbf{K}_t\f$ of step \p t, the first step is 1
+  const arma::mat &getGain(std::size_t t) const {
+    return gains_[index(t - 1)];
+  }
+  //! Returns \f$\mathbf{P}_{t|t}\f$ of step \p t, the first step is 1
+  const arma::mat &getCovariance(std::size_t t) const {
+    return covs_[index(t - 1)];
+  }
+  //! Returns number of computed steps
+  std::size_t size() const { return gains_.size(); }
+  //! Returns true if the last step has converged to the steady state
+  bool isConverged() const { return converged_; }
+
+  /** Checks if the schedule is computed for the given model.
+   *
+   * The dimensions and the initial covariance should agree and the first
+   * step, recomputed from the model, should match the schedule.
+   *
+   * @param tolerance Maximum absolute or relative difference of the first
+   * step.
+   * @return true if the schedule belongs to the model.
+   */
+  bool isFor(const arma::mat &dyn_mat, const arma::mat &dyn_cov,
+             const arma::mat &mes_mat, const arma::mat &mes_cov,
+             const arma::mat &initial_cov, double tolerance = 1e-9) const {
+    const arma::uword n = initial_cov_.n_rows, m = gains_.front().n_cols;
+    if (dyn_mat.n_rows != n || dyn_mat.n_cols != n || dyn_cov.n_rows != n ||
+        dyn_cov.n_cols != n || mes_mat.n_rows != m || mes_mat.n_cols != n ||
+        mes_cov.n_rows != m || mes_cov.n_cols != m ||
+        !arma::approx_equal(initial_cov, initial_cov_, "absdiff", 0.0))
+      return false;
+    arma::mat p_cov, gain, next_cov;
+    recursion(dyn_mat, dyn_cov, mes_mat, mes_cov, initial_cov_, p_cov, gain,
+              next_cov);
+    return arma::approx_equal(p_cov, p_covs_.front(), "both", tolerance,
+                              tolerance) &&
+           arma::approx_equal(gain, gains_.front(), "both", tolerance,
+                              tolerance);
+  }
+};
+
+/** Builds the gain schedule of a process with linear Gaussian maps, see
+ * GainSchedule::GainSchedule.
+ */
+template <class STA_MAP, class OBS_MAP>
+std::shared_ptr<const GainSchedule> makeGainSchedule(
+    process::Hierarchical<
+        process::Markov<distribution::Gaussian, STA_MAP, distribution::Gaussian>,
+        process::Memoryless<distribution::Gaussian, OBS_MAP>> process,
+    std::size_t max_steps = 1000, double tolerance = 1e-12) {
+  const STA_MAP &dyn_map =
+      process.template getProcess<0>().getCPDF().getParamMap();
+  const OBS_MAP &mes_map =
+      process.template getProcess<1>().getCPDF().getParamMap();
+  return std::make_shared<const GainSchedule>(
+      detail::denseTransfer(dyn_map), detail::denseCovariance(dyn_map),
+      detail::denseTransfer(mes_map), detail::denseCovariance(mes_map),
+      process.template getProcess<0>().getInitialPDF().getCovariance(),
+      max_steps, tolerance);
+}
+
+} // namespace filter
+} // namespace ssmkit
+
+#endif // SSMPACK_FILTER_GAIN_SCHEDULE_HPP
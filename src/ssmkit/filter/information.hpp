@@ -0,0 +1,167 @@
+/**
+ * @file information.hpp
+ * @author Vahid Bastani
+ *
+ * Implementation of information filter
+ */
+#ifndef SSMPACK_FILTER_INFORMATION_HPP
+#define SSMPACK_FILTER_INFORMATION_HPP
+
+#include "ssmkit/distribution/gaussian.hpp"
+#include "ssmkit/distribution/conditional.hpp"
+#include "ssmkit/process/markov.hpp"
+#include "ssmkit/process/memoryless.hpp"
+#include "ssmkit/process/hierarchical.hpp"
+#include "ssmkit/filter/recursive_bayesian_base.hpp"
+#include <armadillo>
+
+#include <tuple>
+
+namespace ssmkit {
+namespace filter {
+
+using process::Hierarchical;
+using process::Markov;
+using process::Memoryless;
+using distribution::Conditional;
+using distribution::Gaussian;
+
+/** Information filter
+ *
+ * Same model and interface as filter::Kalman, but the correction is done in
+ * the information form
+ * \f{equation}{\mathbf{P}_{t|t}^{-1} = \mathbf{P}_{t|t-1}^{-1} +
+ * \mathbf{H}^T\mathbf{R}^{-1}\mathbf{H}\f}
+ * so only \f$n \times n\f$ matrices are inverted per step. It is meant for
+ * measurements of much higher dimension \f$m\f$ than the state \f$n\f$:
+ * \f$\mathbf{H}^T\mathbf{R}^{-1}\f$ and \f$\mathbf{H}^T\mathbf{R}^{-1}\mathbf{H}\f$
+ * are computed once at construction, the maps of the owned process cannot
+ * change, so a step costs \f$O(n^3 + mn)\f$ instead of \f$O(m^3)\f$. The
+ * means are written into a workspace by the \a mean method of the maps if
+ * they have one (see map::LinearGaussian::mean), so \f$\mathbf{R}\f$ is not
+ * touched per step.
+ */
+template <class STA_MAP, class OBS_MAP>
+class Information
+    : public RecursiveBayesianBase<Information<STA_MAP, OBS_MAP>> {
+
+ public:
+  //! Type of process object
+  using TProcess =
+      Hierarchical<Markov<Gaussian, STA_MAP, Gaussian>,
+                   Memoryless<Gaussian, OBS_MAP>>;
+  //! Type of the posterior state \f$(\hat{\mathbf{x}}, \hat{\mathbf{P}})\f$
+  using TCompeleteState =
+      std::tuple<arma::vec, arma::mat>;
+
+ private:
+  //! The process object
+  TProcess process_;
+  //! The dynamic map holding the state transition matrix \f$\mathbf{F}\f$
+  const STA_MAP &dyn_map_;
+  //! The measurement map holding the measurement matrix \f$\mathbf{H}\f$
+  const OBS_MAP &mes_map_;
+  //! The covariance of dynamic noise \f$\mathbf{Q}\f$
+  const arma::mat &dyn_cov_;
+  //! The covariance of measurement noise \f$\mathbf{R}\f$
+  const arma::mat &mes_cov_;
+  //! \f$\mathbf{H}^T\mathbf{R}^{-1}\f$
+  arma::mat mes_gain_;
+  //! \f$\mathbf{H}^T\mathbf{R}^{-1}\mathbf{H}\f$
+  arma::mat mes_info_;
+  //! The corrected state vector \f$\mathbf{x}_{t|t}\f$
+  arma::vec state_vec_;
+  //! The corrected state covariance \f$\mathbf{P}_{t|t}\f$
+  arma::mat state_cov_;
+  //! The corrected information matrix \f$\mathbf{P}_{t|t}^{-1}\f$
+  arma::mat state_info_;
+  //! The predicted state vector \f$\mathbf{x}_{t|t-1}\f$
+  arma::vec p_state_vec_;
+  //! The predicted state covariance \f$\mathbf{P}_{t|t-1}\f$
+  arma::mat p_state_cov_;
+  // workspace of a step, kept between the steps to avoid allocations
+  arma::vec mes_mean_, inovation_;
+
+ public:
+  /** Construct an information filter
+   *
+   * Construct an information filter with parameters taken from \p process
+   * argument.
+   */
+  Information(const TProcess &process)
+      : process_(process),
+        dyn_map_(process_.template getProcess<0>().getCPDF().getParamMap()),
+        mes_map_(process_.template getProcess<1>().getCPDF().getParamMap()),
+        dyn_cov_(dyn_map_.covariance), mes_cov_(mes_map_.covariance) {
+    // R is symmetric, thus (R^-1 H)^T = H^T R^-1
+    mes_gain_ = arma::solve(mes_cov_, mes_map_.transfer).t();
+    mes_info_ = mes_gain_ * mes_map_.transfer;
+  }
+
+  /** Prediction
+   *
+   * Performs the prediction step in the covariance form, see Kalman::predict.
+   *
+   * @param args... Control variables of the dynamic process, if any.
+   */
+  template <class... TArgs>
+  void predict(const TArgs &... args) {
+    distribution::detail::mapMean(p_state_vec_, dyn_map_, state_vec_, args...);
+    p_state_cov_ =
+        dyn_map_.transfer * state_cov_ * dyn_map_.transfer.t() + dyn_cov_;
+  }
+
+  /** Correction
+   *
+   * Performs correction step in the information form.
+   *
+   * \f{equation}{\mathbf{P}_{t|t} = (\mathbf{P}_{t|t-1}^{-1} +
+   * \mathbf{H}^T\mathbf{R}^{-1}\mathbf{H})^{-1}\f}
+   * \f{equation}{\hat{\mathbf{x}}_{t|t}=\hat{\mathbf{x}}_{t|t-1}+
+   * \mathbf{P}_{t|t}\mathbf{H}^T\mathbf{R}^{-1}\tilde{\mathbf{z}}_t \f}
+   *
+   * @param measurement Measurement vector \f$\mathbf{z}_t\f$.
+   * @param args... Control variables of the measurement process, if any.
+   * @return Estimated state \f$(\hat{\mathbf{x}}_{t|t}, \mathbf{P}_{t|t})\f$
+   */
+  template <class... TArgs>
+  TCompeleteState correct(const arma::vec &measurement,
+                          const TArgs &... args) {
+    // the measured mean is written into the workspace, R is not copied
+    distribution::detail::mapMean(mes_mean_, mes_map_, p_state_vec_, args...);
+    inovation_ = measurement;
+    inovation_ -= mes_mean_;
+
+    state_info_ = arma::inv_sympd(p_state_cov_) + mes_info_;
+    state_cov_ = arma::inv_sympd(state_info_);
+    state_vec_ = p_state_vec_ + state_cov_ * (mes_gain_ * inovation_);
+    return std::make_tuple(state_vec_, state_cov_);
+  }
+
+  /** Initialization
+   *
+   * @return Initial state \f$(\hat{\mathbf{x}}_{0|0}, \mathbf{P}_{0|0})\f$
+   */
+  TCompeleteState initialize() {
+    state_vec_ = process_.template getProcess<0>().getInitialPDF().getMean();
+    state_cov_ =
+        process_.template getProcess<0>().getInitialPDF().getCovariance();
+    state_info_ = arma::inv_sympd(state_cov_);
+    return std::make_tuple(state_vec_, state_cov_);
+  }
+
+  //! Returns the corrected information matrix \f$\mathbf{P}_{t|t}^{-1}\f$
+  const arma::mat &getInformationMatrix() const { return state_info_; }
+};
+
+template <class STA_MAP, class OBS_MAP>
+Information<STA_MAP, OBS_MAP> makeInformation(
+    Hierarchical<Markov<Gaussian, STA_MAP, Gaussian>,
+                 Memoryless<Gaussian, OBS_MAP>> process) {
+  return Information<STA_MAP, OBS_MAP>(process);
+}
+
+} // namespace filter
+} // namespace ssmkit
+
+#endif // SSMPACK_FILTER_INFORMATION_HPP
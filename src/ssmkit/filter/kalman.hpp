@@ -13,8 +13,18 @@
 #include "ssmkit/process/memoryless.hpp"
 #include "ssmkit/process/hierarchical.hpp"
 #include "ssmkit/filter/recursive_bayesian_base.hpp"
+#include "ssmkit/filter/gain_schedule.hpp"
+#include "ssmkit/map/block_linear_gaussian.hpp"
 #include <armadillo>
 
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
 namespace ssmkit {
 namespace filter {
 
@@ -24,7 +34,150 @@ using process::Memoryless;
 using distribution::Conditional;
 using distribution::Gaussian;
 
+/// @cond DEV
+namespace detail {
+/* true if the map is discretized per step and provides discretization(args...)
+ * holding the transfer and covariance of the step, see
+ * map::ContinuousLinearGaussian
+ */
+template <class TMap, class TArgs, class = void>
+struct HasDiscretization : std::false_type {};
+
+template <class TMap, class... Args>
+struct HasDiscretization<
+    TMap, std::tuple<Args...>,
+    typename distribution::detail::Void<decltype(
+        std::declval<const TMap &>().discretization(
+            std::declval<const Args &>()...))>::type> : std::true_type {};
+
+template <class TMap, class... Args>
+const TMap &selectStepModel(std::false_type, const TMap &map,
+                            const Args &...) {
+  return map;
+}
+
+template <class TMap, class... Args>
+decltype(auto) selectStepModel(std::true_type, const TMap &map,
+                               const Args &... args) {
+  return map.discretization(args...);
+}
+
+// the model holding F and Q (or H and R) of a step: the map itself or its
+// discretization for the controls of the step
+template <class TMap, class... Args>
+decltype(auto) stepModel(const TMap &map, const Args &... args) {
+  return selectStepModel(HasDiscretization<TMap, std::tuple<Args...>>(), map,
+                         args...);
+}
+
+// F M (or H M) into out, block by block for block maps
+template <class TMap>
+void transferProduct(arma::mat &out, const TMap &map, const arma::mat &m,
+                     std::false_type) {
+  out = map.transfer * m;
+}
+
+template <class TMap>
+void transferProduct(arma::mat &out, const TMap &map, const arma::mat &m,
+                     std::true_type) {
+  map::blockMultiply(out, map.block_transfer, map.blocks, m);
+}
+
+template <class TMap>
+void transferProduct(arma::mat &out, const TMap &map, const arma::mat &m) {
+  transferProduct(out, map, m, IsBlockMap<TMap>());
+}
+
+// out += Q (or R), only the diagonal blocks for block maps
+template <class TMap>
+void addCovariance(arma::mat &out, const TMap &map, std::false_type) {
+  out += map.covariance;
+}
+
+template <class TMap>
+void addCovariance(arma::mat &out, const TMap &map, std::true_type) {
+  const arma::uword b = map.block_covariance.n_rows;
+  for (arma::uword i = 0; i < map.blocks; i++)
+    out.submat(i * b, i * b, i * b + b - 1, i * b + b - 1) +=
+        map.block_covariance;
+}
+
+template <class TMap>
+void addCovariance(arma::mat &out, const TMap &map) {
+  addCovariance(out, map, IsBlockMap<TMap>());
+}
+
+/* the upper triangle of A B^T into out, the rest of out is not set. The
+ * columns are done in panels by BLAS, each panel only down to its diagonal,
+ * so it costs about half the flops of the full product.
+ */
+inline void upperProduct(arma::mat &out, const arma::mat &a,
+                         const arma::mat &b) {
+  const arma::uword k = a.n_rows;
+  out.set_size(k, k);
+  if (k == 0)
+    return;
+  if (a.n_cols == 0) {
+    out.zeros();
+    return;
+  }
+  const arma::uword panel = 64;
+  const char no_trans = 'N', trans = 'T';
+  const double one = 1, zero = 0;
+  arma::blas_int lda = a.n_rows, ldb = b.n_rows, ldc = out.n_rows,
+                 depth = a.n_cols;
+  for (arma::uword first = 0; first < k; first += panel) {
+    const arma::uword width = std::min(panel, k - first);
+    // rows 0 to the last diagonal element of the panel
+    arma::blas_int rows = first + width, cols = width;
+    arma::blas::gemm(&no_trans, &trans, &rows, &cols, &depth, &one,
+                     a.memptr(), &lda, b.memptr() + first, &ldb, &zero,
+                     out.colptr(first), &ldc);
+  }
+}
+
+inline void upperProduct(arma::mat &out, const arma::mat &a,
+                         const arma::sp_mat &b) {
+  out = a * b.t();
+}
+
+// row i of H as a dense column vector
+inline void transferRow(arma::vec &out, const arma::mat &mat, arma::uword i) {
+  out = mat.row(i).t();
+}
+
+inline void transferRow(arma::vec &out, const arma::sp_mat &mat,
+                        arma::uword i) {
+  out.zeros(mat.n_cols);
+  for (auto it = mat.begin_row(i); it != mat.end_row(i); ++it)
+    out.at(it.col()) = *it;
+}
+
+} // namespace detail
+/// @endcond
+
 /** Kalman filter
+ *
+ * Block structured maps (see map::BlockLinearGaussian) are multiplied block
+ * by block. If both maps have the same blocks and the initial covariance has
+ * no cross-covariance between the blocks, the blocks stay independent and
+ * are filtered separately, so a step costs linear in the number of blocks.
+ *
+ * If the measurement noise covariance \f$\mathbf{R}\f$ is diagonal the
+ * measurement components are processed one at a time with rank-1 updates,
+ * without inverting the innovation covariance.
+ *
+ * The covariances are computed by BLAS matrix products and kept exactly
+ * symmetric by mirroring their upper triangles, so they do not drift away
+ * from symmetry in long runs.
+ *
+ * The temporaries of a step are kept in a workspace owned by the filter,
+ * and the means are written into it by the \a mean method of the maps if
+ * they have one (see map::LinearGaussian::mean). With dense maps and no
+ * controls, predict() followed by correctInPlace() does not allocate once the
+ * workspace has its size from the first step;
+ * the posterior is then read by getStateVector() and getStateCovariance().
+ * correct() is the same step returning a copy of the posterior.
  */
 template <class STA_MAP, class OBS_MAP>
 class Kalman
@@ -40,16 +193,17 @@ class Kalman
       std::tuple<arma::vec, arma::mat>;
 
  private:
+  using TDynBlock = detail::IsBlockMap<STA_MAP>;
+  using TMesBlock = detail::IsBlockMap<OBS_MAP>;
+  using TBlocks =
+      std::integral_constant<bool, TDynBlock::value && TMesBlock::value>;
+
   //! The process object
   TProcess process_;
-  //! The state transition matrix \f$\mathbf{F}\f$
-  const arma::mat &dyn_mat_;
-  //! The measurement matrix \f$\mathbf{H}\f$
-  const arma::mat &mes_mat_;
-  //! The covariance of dynamic noise \f$\mathbf{Q}\f$
-  const arma::mat &dyn_cov_;
-  //! The covariance of measurement noise \f$\mathbf{R}\f$
-  const arma::mat &mes_cov_;
+  //! The dynamic map holding the state transition matrix \f$\mathbf{F}\f$
+  const STA_MAP &dyn_map_;
+  //! The measurement map holding the measurement matrix \f$\mathbf{H}\f$
+  const OBS_MAP &mes_map_;
   //! The corrected state vector \f$\mathbf{x}_{t|t}\f$
   arma::vec state_vec_;
   //! The corrected state covariance \f$\mathbf{P}_{t|t}\f$
@@ -58,6 +212,202 @@ class Kalman
   arma::vec p_state_vec_;
   //! The predicted state covariance \f$\mathbf{P}_{t|t-1}\f$
   arma::mat p_state_cov_;
+  //! True if the blocks of the state are independent and filtered separately
+  bool decoupled_ = false;
+  //! True if the covariances and the gain are frozen at their steady state
+  bool steady_ = false;
+  //! Tolerance of the steady state detection, zero if disabled
+  double steady_tolerance_ = 0;
+  //! The steady state gain \f$\mathbf{K}_\infty\f$
+  arma::mat steady_gain_;
+  //! The corrected state covariance of the previous step
+  arma::mat last_state_cov_;
+  //! The shared covariance and gain sequence, if any
+  std::shared_ptr<const GainSchedule> schedule_;
+  //! Number of corrections since initialization
+  std::size_t step_ = 0;
+  //! True if predict() has been called since the last correction
+  bool predicted_ = false;
+  // workspace of a step, kept between the steps to avoid allocations
+  arma::vec mes_mean_, inovation_, w_inovation_, h_, ph_, delta_;
+  arma::mat fp_, hp_, trans_, inovation_cov_, chol_, whiten_;
+  arma::mat whiten_prod_;
+
+  // freezes the gain for the current predicted covariance
+  void freeze() {
+    const arma::mat mes_mat = detail::denseTransfer(mes_map_);
+    arma::mat hp = mes_mat * p_state_cov_;
+    steady_gain_ = hp.t() * arma::inv_sympd(hp * mes_mat.t() +
+                                            detail::denseCovariance(mes_map_));
+    state_cov_ = p_state_cov_ - steady_gain_ * hp;
+    last_state_cov_.reset();
+    steady_ = true;
+  }
+
+  /* out = M F^T + Q (or M H^T + R) for M = F P (or H P), mirroring the
+   * upper triangle; dense maps compute only the upper triangle of M F^T,
+   * sparse maps the full product. Block maps multiply F M^T, the transpose
+   * of the same symmetric product, through the trans workspace
+   */
+  template <class TMap>
+  static void symmetricProduct(arma::mat &out, arma::mat &, const TMap &map,
+                               const arma::mat &m, std::false_type) {
+    detail::upperProduct(out, m, map.transfer);
+    detail::addCovariance(out, map);
+    out = arma::symmatu(out);
+  }
+
+  template <class TMap>
+  static void symmetricProduct(arma::mat &out, arma::mat &trans,
+                               const TMap &map, const arma::mat &m,
+                               std::true_type) {
+    trans = m.t();
+    detail::transferProduct(out, map, trans);
+    detail::addCovariance(out, map);
+    out = arma::symmatu(out);
+  }
+
+  bool isDecoupled(std::false_type) const { return false; }
+
+  bool isDecoupled(std::true_type) const {
+    const arma::uword b = dyn_map_.block_transfer.n_rows;
+    if (dyn_map_.blocks != mes_map_.blocks ||
+        mes_map_.block_transfer.n_cols != b)
+      return false;
+    arma::mat block_diagonal =
+        arma::kron(arma::eye<arma::mat>(dyn_map_.blocks, dyn_map_.blocks),
+                   arma::ones<arma::mat>(b, b));
+    return arma::approx_equal(state_cov_, state_cov_ % block_diagonal,
+                              "absdiff", 0.0);
+  }
+
+  // model is the dynamic map, or its discretization for the step
+  template <class TModel>
+  void predictCovariance(const TModel &model, std::false_type) {
+    detail::transferProduct(fp_, model, state_cov_);
+    symmetricProduct(p_state_cov_, trans_, model, fp_,
+                     detail::IsBlockMap<TModel>());
+  }
+
+  template <class TModel>
+  void predictCovariance(const TModel &model, std::true_type) {
+    if (!decoupled_)
+      return predictCovariance(model, std::false_type());
+    const arma::mat &f = model.block_transfer;
+    const arma::uword b = f.n_rows;
+    // off-diagonal blocks stay zero
+    for (arma::uword i = 0; i < model.blocks; i++) {
+      const arma::uword first = i * b, last = first + b - 1;
+      p_state_cov_.submat(first, first, last, last) = arma::symmatu(
+          f * state_cov_.submat(first, first, last, last) * f.t() +
+          model.block_covariance);
+    }
+  }
+
+  // block maps are corrected as a whole
+  bool correctSequential(std::true_type) { return false; }
+
+  /* processes the measurement components one by one with rank-1 updates if
+   * R is diagonal, i.e. the components are independent given the state;
+   * returns false otherwise. Only the upper triangle of the covariance is
+   * updated and read, column by column, it is mirrored at the end. Throws
+   * std::runtime_error if the variance of a component is not positive.
+   */
+  bool correctSequential(std::false_type) {
+    const auto &mes_cov = mes_map_.covariance;
+    if (!mes_cov.is_diagmat())
+      return false;
+    const arma::uword n = p_state_vec_.n_elem;
+    // change of the state vector by the components processed so far
+    delta_.zeros(n);
+    state_cov_ = p_state_cov_;
+    for (arma::uword i = 0; i < inovation_.n_elem; i++) {
+      detail::transferRow(h_, mes_map_.transfer, i);
+      // P h^T from the upper triangle of the symmetric P
+      ph_.zeros(n);
+      for (arma::uword c = 0; c < n; c++) {
+        const double *col = state_cov_.colptr(c);
+        const double hc = h_.at(c);
+        double sum = 0;
+        for (arma::uword r = 0; r < c; r++) {
+          ph_.at(r) += col[r] * hc;
+          sum += col[r] * h_.at(r);
+        }
+        ph_.at(c) += sum + col[c] * hc;
+      }
+      // s = h P h^T + r and the innovation of the component
+      const double s = mes_cov(i, i) + arma::dot(h_, ph_);
+      if (!(s > 0))
+        throw std::runtime_error(
+            "Kalman::correct(): innovation variance is not positive");
+      const double nu = inovation_(i) - arma::dot(h_, delta_);
+      delta_ += (nu / s) * ph_;
+      // rank-1 update P - P h^T h P / s of the upper triangle
+      for (arma::uword c = 0; c < n; c++) {
+        double *col = state_cov_.colptr(c);
+        const double pc = ph_.at(c) / s;
+        for (arma::uword r = 0; r <= c; r++)
+          col[r] -= ph_.at(r) * pc;
+      }
+    }
+    state_cov_ = arma::symmatu(state_cov_);
+    state_vec_ += delta_;
+    return true;
+  }
+
+  /* S = L L^T, then with W = L^-1 H P the update is x + W^T L^-1 z and
+   * P - W^T W, no inverse is formed; the state vector should hold the
+   * predicted one. Throws std::runtime_error if S is not positive definite.
+   */
+  void correctState(std::false_type) {
+    if (correctSequential(TMesBlock()))
+      return;
+    // P H^T is the transpose of H P since P is symmetric
+    detail::transferProduct(hp_, mes_map_, p_state_cov_);
+    symmetricProduct(inovation_cov_, trans_, mes_map_, hp_, TMesBlock());
+
+    if (!arma::chol(chol_, inovation_cov_, "lower"))
+      throw std::runtime_error(
+          "Kalman::correct(): innovation covariance is not positive definite");
+    // W and L^-1 z by triangular solves, without the condition estimate
+    whiten_ = arma::solve(arma::trimatl(chol_), hp_, arma::solve_opts::fast);
+    w_inovation_ =
+        arma::solve(arma::trimatl(chol_), inovation_, arma::solve_opts::fast);
+
+    state_vec_ += whiten_.t() * w_inovation_;
+    // P - W^T W, Armadillo computes W^T W by a symmetric rank-k update
+    whiten_prod_ = whiten_.t() * whiten_;
+    state_cov_ = p_state_cov_ - whiten_prod_;
+  }
+
+  // the same factorization as the dense correction for every block
+  void correctState(std::true_type) {
+    if (!decoupled_)
+      return correctState(std::false_type());
+    const arma::mat &h = mes_map_.block_transfer;
+    const arma::uword b = h.n_cols, m = h.n_rows;
+    for (arma::uword i = 0; i < mes_map_.blocks; i++) {
+      const arma::uword first = i * b, last = first + b - 1;
+      // fp_ is free during the correction, it holds the predicted block
+      fp_ = p_state_cov_.submat(first, first, last, last);
+      hp_ = h * fp_;
+      inovation_cov_ = hp_ * h.t();
+      inovation_cov_ += mes_map_.block_covariance;
+      inovation_cov_ = arma::symmatu(inovation_cov_);
+
+      if (!arma::chol(chol_, inovation_cov_, "lower"))
+        throw std::runtime_error("Kalman::correct(): innovation covariance "
+                                 "is not positive definite");
+      whiten_ = arma::solve(arma::trimatl(chol_), hp_, arma::solve_opts::fast);
+      w_inovation_ = arma::solve(arma::trimatl(chol_),
+                                 inovation_.subvec(i * m, i * m + m - 1),
+                                 arma::solve_opts::fast);
+
+      state_vec_.subvec(first, last) += whiten_.t() * w_inovation_;
+      whiten_prod_ = whiten_.t() * whiten_;
+      state_cov_.submat(first, first, last, last) = fp_ - whiten_prod_;
+    }
+  }
 
  public:
   /** Construct a Kalman filter
@@ -66,18 +416,8 @@ class Kalman
    */
   Kalman(const TProcess &process)
       : process_(process),
-        dyn_mat_(
-            process_.template getProcess<0>().getCPDF().getParamMap().transfer),
-        mes_mat_(
-            process_.template getProcess<1>().getCPDF().getParamMap().transfer),
-        dyn_cov_(process_.template getProcess<0>()
-                     .getCPDF()
-                     .getParamMap()
-                     .covariance),
-        mes_cov_(process_.template getProcess<1>()
-                     .getCPDF()
-                     .getParamMap()
-                     .covariance) {}
+        dyn_map_(process_.template getProcess<0>().getCPDF().getParamMap()),
+        mes_map_(process_.template getProcess<1>().getCPDF().getParamMap()) {}
 
   
   /** Prediction
@@ -93,11 +433,10 @@ class Kalman
   template <class... TArgs>
   void predict(const TArgs &... args) {
     // use the map function to pass controls, avoiding control definition
-    // is move used here??
-    p_state_vec_ =
-        std::get<0>(process_.template getProcess<0>().getCPDF().getParamMap()(
-            state_vec_, args...));
-    p_state_cov_ = dyn_mat_ * state_cov_ * dyn_mat_.t() + dyn_cov_;
+    distribution::detail::mapMean(p_state_vec_, dyn_map_, state_vec_, args...);
+    if (!steady_ && !schedule_)
+      predictCovariance(detail::stepModel(dyn_map_, args...), TBlocks());
+    predicted_ = true;
   }
   
   /** Correction
@@ -117,29 +456,211 @@ class Kalman
   template <class... TArgs>
   TCompeleteState correct(const arma::vec &measurement,
                           const TArgs &... args) {
-    arma::vec inovation =
-        measurement -
-        std::get<0>(process_.template getProcess<1>().getCPDF().getParamMap()(
-            p_state_vec_, args...));
-
-    arma::mat inovation_cov = mes_mat_ * p_state_cov_ * mes_mat_.t() + mes_cov_;
-    arma::mat kalman_gain =
-        p_state_cov_ * mes_mat_.t() * arma::inv_sympd(inovation_cov);
+    correctInPlace(measurement, args...);
+    return std::make_tuple(state_vec_, getStateCovariance());
+  }
 
-    state_vec_ = p_state_vec_ + kalman_gain * inovation;
-    state_cov_ = p_state_cov_ - kalman_gain * mes_mat_ * p_state_cov_;
-    return std::make_tuple(state_vec_, state_cov_);
+  /** Correction without returning the posterior.
+   *
+   * Performs the same correction step as correct(), the posterior is kept
+   * in the filter and read by getStateVector() and getStateCovariance().
+   *
+   * @param measurement Measurement vector \f$\mathbf{z}_t\f$.
+   * @param args... Control variables of the measurement process, if any.
+   */
+  template <class... TArgs>
+  void correctInPlace(const arma::vec &measurement, const TArgs &... args) {
+    if (schedule_ && !predicted_ && step_ == 0)
+      throw std::logic_error(
+          "Kalman::correct(): no prediction since initialize()");
+    distribution::detail::mapMean(mes_mean_, mes_map_, p_state_vec_, args...);
+    inovation_ = measurement;
+    inovation_ -= mes_mean_;
+    state_vec_ = p_state_vec_;
+    // a correction without a new prediction corrects the same step again
+    if (predicted_)
+      step_++;
+    predicted_ = false;
+    if (schedule_) {
+      state_vec_ += schedule_->getGain(step_) * inovation_;
+      return;
+    }
+    if (steady_) {
+      state_vec_ += steady_gain_ * inovation_;
+      return;
+    }
+    correctState(TBlocks());
+    if (steady_tolerance_ > 0) {
+      if (arma::approx_equal(state_cov_, last_state_cov_, "absdiff",
+                             steady_tolerance_))
+        freeze();
+      else
+        last_state_cov_ = state_cov_;
+    }
   }
+
   /** Initialization
+   *
+   * A frozen filter (see detectSteadyState() and solveSteadyState()) stays
+   * frozen and starts from the initial mean with the steady state
+   * covariance; call unfreeze() before to start from the initial covariance.
    *
    * @return Initial state \f$(\hat{\mathbf{x}}_{0|0}, \mathbf{P}_{0|0})\f$
    */
   TCompeleteState initialize() {
     state_vec_ = process_.template getProcess<0>().getInitialPDF().getMean();
+    step_ = 0;
+    predicted_ = false;
+    if (schedule_)
+      return std::make_tuple(state_vec_, schedule_->getInitialCovariance());
+    // a frozen filter runs in the steady state from the start
+    if (steady_)
+      return std::make_tuple(state_vec_, state_cov_);
     state_cov_ =
         process_.template getProcess<0>().getInitialPDF().getCovariance();
+    decoupled_ = isDecoupled(TBlocks());
+    if (decoupled_)
+      p_state_cov_ = state_cov_;
     return std::make_tuple(state_vec_, state_cov_);
   }
+
+  /** Enables steady state detection.
+   *
+   * For a time-invariant model the covariance recursion does not depend on
+   * the measurements and converges. Once two consecutive corrected
+   * covariances differ less than \p tolerance the covariances and the gain
+   * are frozen, after that a step only updates the mean.
+   *
+   * @param tolerance Maximum absolute difference of the covariances.
+   * @return Reference to the current instance.
+   */
+  Kalman &detectSteadyState(double tolerance = 1e-10) {
+    steady_tolerance_ = tolerance;
+    return (*this);
+  }
+
+  /** Solves the steady state up front and freezes the filter.
+   *
+   * The predicted covariance is the solution of the discrete algebraic
+   * Riccati equation
+   * \f{equation}{\mathbf{P} = \mathbf{F}\mathbf{P}\mathbf{F}^T -
+   * \mathbf{F}\mathbf{P}\mathbf{H}^T(\mathbf{H}\mathbf{P}\mathbf{H}^T +
+   * \mathbf{R})^{-1}\mathbf{H}\mathbf{P}\mathbf{F}^T + \mathbf{Q}\f}
+   * found by the structured doubling algorithm, which converges
+   * quadratically. The model should be time-invariant, detectable and
+   * stabilizable.
+   *
+   * @param tolerance Convergence tolerance of the solution.
+   * @param max_iteration Maximum number of doubling iterations.
+   * @return Reference to the current instance.
+   * @throw std::runtime_error if the iteration does not converge, the filter
+   * is then left unchanged.
+   */
+  Kalman &solveSteadyState(double tolerance = 1e-12,
+                           unsigned int max_iteration = 100) {
+    const arma::mat dyn_mat = detail::denseTransfer(dyn_map_);
+    const arma::mat mes_mat = detail::denseTransfer(mes_map_);
+    const arma::mat eye =
+        arma::eye<arma::mat>(dyn_mat.n_rows, dyn_mat.n_rows);
+    arma::mat a = dyn_mat.t();
+    arma::mat g =
+        mes_mat.t() * arma::solve(detail::denseCovariance(mes_map_), mes_mat);
+    arma::mat p = detail::denseCovariance(dyn_map_);
+    bool converged = false;
+    for (unsigned int i = 0; i < max_iteration && !converged; i++) {
+      const arma::mat w = arma::inv(eye + g * p);
+      const arma::mat aw = a * w;
+      const arma::mat p_next = p + a.t() * p * w * a;
+      g += aw * g * a.t();
+      a = aw * a;
+      converged = arma::approx_equal(p_next, p, "absdiff", tolerance);
+      p = p_next;
+    }
+    if (!converged)
+      throw std::runtime_error(
+          "Kalman::solveSteadyState(): Riccati iteration did not converge");
+    p_state_cov_ = p;
+    freeze();
+    return (*this);
+  }
+
+  /** Unfreezes a filter frozen at its steady state.
+   *
+   * The covariance recursion runs again from the current (steady state)
+   * covariance, or from the initial one after initialize(). Steady state
+   * detection, if enabled by detectSteadyState(), stays enabled.
+   *
+   * @return Reference to the current instance.
+   */
+  Kalman &unfreeze() {
+    steady_ = false;
+    last_state_cov_.reset();
+    return (*this);
+  }
+
+  /** Uses a precomputed covariance and gain sequence.
+   *
+   * The filter then keeps no covariance of its own and each step only
+   * updates the mean with the gain of the schedule. The schedule should be
+   * computed for the same model and initial covariance, e.g. by
+   * makeGainSchedule(), and can be shared by any number of filters.
+   *
+   * Steps are counted from initialize(), a step is a predict() followed by
+   * a correct(). As with own covariances, repeated predictions start from
+   * the same corrected state and stay on the same step, and a correction
+   * without a new prediction corrects the same step again.
+   *
+   * @param schedule The schedule, nullptr to compute the covariances again.
+   * @return Reference to the current instance.
+   * @throw std::invalid_argument if the schedule has not converged (see
+   * GainSchedule::isConverged()) or is not computed for the model and the
+   * initial covariance of the filter (see GainSchedule::isFor()).
+   */
+  Kalman &setGainSchedule(std::shared_ptr<const GainSchedule> schedule) {
+    if (schedule && !schedule->isConverged())
+      throw std::invalid_argument(
+          "Kalman::setGainSchedule(): the schedule has not converged");
+    if (schedule &&
+        !schedule->isFor(
+            detail::denseTransfer(dyn_map_), detail::denseCovariance(dyn_map_),
+            detail::denseTransfer(mes_map_), detail::denseCovariance(mes_map_),
+            process_.template getProcess<0>().getInitialPDF().getCovariance()))
+      throw std::invalid_argument("Kalman::setGainSchedule(): the schedule is "
+                                  "not computed for the model of the filter");
+    schedule_ = std::move(schedule);
+    return (*this);
+  }
+
+  //! Returns the corrected state vector \f$\hat{\mathbf{x}}_{t|t}\f$
+  const arma::vec &getStateVector() const { return state_vec_; }
+
+  //! Returns the corrected state covariance \f$\mathbf{P}_{t|t}\f$
+  const arma::mat &getStateCovariance() const {
+    if (!schedule_)
+      return state_cov_;
+    return step_ ? schedule_->getCovariance(step_)
+                 : schedule_->getInitialCovariance();
+  }
+
+  /** Returns the predicted state vector \f$\hat{\mathbf{x}}_{t|t-1}\f$ of
+   * the last prediction.
+   */
+  const arma::vec &getPredictedStateVector() const { return p_state_vec_; }
+
+  /** Returns the predicted state covariance \f$\mathbf{P}_{t|t-1}\f$ of the
+   * last prediction, not maintained when a gain schedule is used.
+   */
+  const arma::mat &getPredictedStateCovariance() const {
+    return p_state_cov_;
+  }
+
+  /** Returns the dynamic map, detail::stepModel() of it gives
+   * \f$\mathbf{F}\f$ and \f$\mathbf{Q}\f$ of a prediction
+   */
+  const STA_MAP &getDynamicMap() const { return dyn_map_; }
+
+  //! Returns true if the filter is frozen at its steady state
+  bool isSteady() const { return steady_; }
 };
 
 template <class STA_MAP, class OBS_MAP>
@@ -0,0 +1,281 @@
+/**
+ * @file kalman_bank.hpp
+ * @author Vahid Bastani
+ *
+ * Bank of Kalman filters sharing one linear Gaussian model.
+ */
+#ifndef SSMPACK_FILTER_KALMAN_BANK_HPP
+#define SSMPACK_FILTER_KALMAN_BANK_HPP
+
+#include "ssmkit/distribution/gaussian.hpp"
+#include "ssmkit/distribution/conditional.hpp"
+#include "ssmkit/process/markov.hpp"
+#include "ssmkit/process/memoryless.hpp"
+#include "ssmkit/process/hierarchical.hpp"
+#include <armadillo>
+
+#include <stdexcept>
+#include <string>
+
+namespace ssmkit {
+namespace filter {
+
+using process::Hierarchical;
+using process::Markov;
+using process::Memoryless;
+using distribution::Conditional;
+using distribution::Gaussian;
+
+/** Bank of independent Kalman filters with an identical model.
+ *
+ * Filters \f$N\f$ tracks, e.g. targets of a multi-object tracker, with the
+ * same \f$\mathbf{F}, \mathbf{Q}, \mathbf{H}, \mathbf{R}\f$ taken from the
+ * linear maps of the process (controls are not supported). The states are
+ * stored as structure of arrays: every element of the means and of the
+ * (packed, symmetric) covariances is one contiguous column of \f$N\f$
+ * values, and the filter equations are evaluated element by element over
+ * all tracks at once, so every inner loop is a vectorizable loop over the
+ * tracks. Zero elements of \f$\mathbf{F}\f$ and \f$\mathbf{H}\f$ are skipped.
+ *
+ * The correction factorizes the innovation covariances
+ * \f$\mathbf{S} = \mathbf{L}\mathbf{L}^T\f$ and with
+ * \f$\mathbf{W} = \mathbf{L}^{-1}\mathbf{H}\mathbf{P}\f$ updates
+ * \f{equation}{\hat{\mathbf{x}} \leftarrow \hat{\mathbf{x}} +
+ * \mathbf{W}^T\mathbf{L}^{-1}\tilde{\mathbf{z}}, \quad
+ * \mathbf{P} \leftarrow \mathbf{P} - \mathbf{W}^T\mathbf{W}\f}
+ */
+template <class STA_MAP, class OBS_MAP>
+class KalmanBank {
+
+ public:
+  //! Type of process object
+  using TProcess =
+      Hierarchical<Markov<Gaussian, STA_MAP, Gaussian>,
+                   Memoryless<Gaussian, OBS_MAP>>;
+
+ private:
+  //! The process object
+  TProcess process_;
+  //! The state transition matrix \f$\mathbf{F}\f$
+  arma::mat dyn_mat_;
+  //! The covariance of dynamic noise \f$\mathbf{Q}\f$
+  arma::mat dyn_cov_;
+  //! The measurement matrix \f$\mathbf{H}\f$
+  arma::mat mes_mat_;
+  //! The covariance of measurement noise \f$\mathbf{R}\f$
+  arma::mat mes_cov_;
+  //! Number of tracks \f$N\f$
+  arma::uword num_;
+  //! State dimension \f$n\f$
+  arma::uword n_;
+  //! Measurement dimension \f$m\f$
+  arma::uword m_;
+  //! The means, \f$N \times n\f$
+  arma::mat means_;
+  //! The packed upper triangles of the covariances, \f$N \times n(n+1)/2\f$
+  arma::mat covs_;
+  // workspace, kept between the steps to avoid allocations
+  arma::mat p_means_, fp_, hp_, inovation_, chol_, inv_diag_;
+
+  //! Column of element \f$(i, j)\f$ of a packed symmetric matrix
+  static arma::uword sym(arma::uword i, arma::uword j) {
+    return i <= j ? j * (j + 1) / 2 + i : i * (i + 1) / 2 + j;
+  }
+
+ public:
+  /** Constructor
+   *
+   * @param process The process model, its maps should provide \a transfer
+   * and \a covariance.
+   * @param num_tracks Number of tracks \f$N\f$.
+   */
+  KalmanBank(const TProcess &process, arma::uword num_tracks)
+      : process_(process),
+        dyn_mat_(process_.template getProcess<0>().getCPDF().getParamMap()
+                     .transfer),
+        dyn_cov_(process_.template getProcess<0>().getCPDF().getParamMap()
+                     .covariance),
+        mes_mat_(process_.template getProcess<1>().getCPDF().getParamMap()
+                     .transfer),
+        mes_cov_(process_.template getProcess<1>().getCPDF().getParamMap()
+                     .covariance),
+        num_(num_tracks), n_(dyn_mat_.n_rows), m_(mes_mat_.n_rows),
+        means_(num_, n_), covs_(num_, n_ * (n_ + 1) / 2) {}
+
+  /** Initializes all the tracks with the initial distribution of the
+   * process.
+   */
+  void initialize() {
+    const Gaussian &initial = process_.template getProcess<0>().getInitialPDF();
+    for (arma::uword t = 0; t < num_; t++)
+      initialize(t, initial.getMean(), initial.getCovariance());
+  }
+
+  /** Initializes one track, e.g. when a new target appears.
+   * @param track Index of the track.
+   * @param mean The state mean.
+   * @param covariance The state covariance.
+   */
+  void initialize(arma::uword track, const arma::vec &mean,
+                  const arma::mat &covariance) {
+    for (arma::uword j = 0; j < n_; j++) {
+      means_(track, j) = mean(j);
+      for (arma::uword i = 0; i <= j; i++)
+        covs_(track, sym(i, j)) = covariance(i, j);
+    }
+  }
+
+  /** Prediction of all the tracks.
+   * \f{equation}{\hat{\mathbf{x}} \leftarrow \mathbf{F}\hat{\mathbf{x}}, \quad
+   * \mathbf{P} \leftarrow \mathbf{F}\mathbf{P}\mathbf{F}^T+\mathbf{Q}\f}
+   */
+  void predict() {
+    p_means_.zeros(num_, n_);
+    for (arma::uword i = 0; i < n_; i++)
+      for (arma::uword k = 0; k < n_; k++)
+        if (dyn_mat_(i, k) != 0)
+          p_means_.col(i) += dyn_mat_(i, k) * means_.col(k);
+    means_.swap(p_means_);
+
+    // F P, element (i, l) in column i n + l
+    fp_.zeros(num_, n_ * n_);
+    for (arma::uword i = 0; i < n_; i++)
+      for (arma::uword k = 0; k < n_; k++)
+        if (dyn_mat_(i, k) != 0)
+          for (arma::uword l = 0; l < n_; l++)
+            fp_.col(i * n_ + l) += dyn_mat_(i, k) * covs_.col(sym(k, l));
+
+    // F P F^T + Q, upper triangle
+    for (arma::uword j = 0; j < n_; j++)
+      for (arma::uword i = 0; i <= j; i++) {
+        covs_.col(sym(i, j)).fill(dyn_cov_(i, j));
+        for (arma::uword l = 0; l < n_; l++)
+          if (dyn_mat_(j, l) != 0)
+            covs_.col(sym(i, j)) += dyn_mat_(j, l) * fp_.col(i * n_ + l);
+      }
+  }
+
+  /** Correction of all the tracks.
+   * @param measurements \f$N \times m\f$ matrix, row \f$t\f$ is the
+   * measurement of track \f$t\f$.
+   */
+  void correct(const arma::mat &measurements) {
+    correct(measurements, arma::ones<arma::uvec>(num_));
+  }
+
+  /** Correction of the tracks selected by \p mask.
+   * @param measurements \f$N \times m\f$ matrix, row \f$t\f$ is the
+   * measurement of track \f$t\f$, rows of unselected tracks are ignored.
+   * @param mask Vector of \f$N\f$ elements, tracks with zero elements have
+   * no measurement and keep their predicted state.
+   * @throw std::runtime_error if the innovation covariance of a track is
+   * not positive definite, the tracks then keep their predicted states.
+   */
+  void correct(const arma::mat &measurements, const arma::uvec &mask) {
+    const arma::uvec missing = arma::find(mask == 0);
+
+    // innovation, H x subtracted from the measurements
+    inovation_ = measurements;
+    if (!missing.is_empty())
+      inovation_.rows(missing).zeros();
+    for (arma::uword r = 0; r < m_; r++)
+      for (arma::uword k = 0; k < n_; k++)
+        if (mes_mat_(r, k) != 0)
+          inovation_.col(r) -= mes_mat_(r, k) * means_.col(k);
+
+    // H P, element (r, c) in column r n + c
+    hp_.zeros(num_, m_ * n_);
+    for (arma::uword r = 0; r < m_; r++)
+      for (arma::uword k = 0; k < n_; k++)
+        if (mes_mat_(r, k) != 0)
+          for (arma::uword c = 0; c < n_; c++)
+            hp_.col(r * n_ + c) += mes_mat_(r, k) * covs_.col(sym(k, c));
+
+    // S = H P H^T + R, packed
+    chol_.set_size(num_, m_ * (m_ + 1) / 2);
+    for (arma::uword s = 0; s < m_; s++)
+      for (arma::uword r = 0; r <= s; r++) {
+        chol_.col(sym(r, s)).fill(mes_cov_(r, s));
+        for (arma::uword c = 0; c < n_; c++)
+          if (mes_mat_(s, c) != 0)
+            chol_.col(sym(r, s)) += mes_mat_(s, c) * hp_.col(r * n_ + c);
+      }
+
+    // S = L L^T in place, L(i, j) for i >= j in column sym(i, j)
+    inv_diag_.set_size(num_, m_);
+    for (arma::uword j = 0; j < m_; j++) {
+      for (arma::uword k = 0; k < j; k++)
+        chol_.col(sym(j, j)) -= arma::square(chol_.col(sym(j, k)));
+      // the state is not changed yet, NaN pivots fail the test as well
+      const double *pivot = chol_.colptr(sym(j, j));
+      for (arma::uword t = 0; t < num_; t++)
+        if (!(pivot[t] > 0))
+          throw std::runtime_error(
+              "KalmanBank::correct(): innovation covariance of track " +
+              std::to_string(t) + " is not positive definite");
+      chol_.col(sym(j, j)) = arma::sqrt(chol_.col(sym(j, j)));
+      inv_diag_.col(j) = 1 / chol_.col(sym(j, j));
+      for (arma::uword i = j + 1; i < m_; i++) {
+        for (arma::uword k = 0; k < j; k++)
+          chol_.col(sym(i, j)) -= chol_.col(sym(i, k)) % chol_.col(sym(j, k));
+        chol_.col(sym(i, j)) %= inv_diag_.col(j);
+      }
+    }
+
+    // W = L^-1 H P and L^-1 z by forward substitution, in place
+    for (arma::uword r = 0; r < m_; r++) {
+      for (arma::uword k = 0; k < r; k++) {
+        for (arma::uword c = 0; c < n_; c++)
+          hp_.col(r * n_ + c) -= chol_.col(sym(r, k)) % hp_.col(k * n_ + c);
+        inovation_.col(r) -= chol_.col(sym(r, k)) % inovation_.col(k);
+      }
+      for (arma::uword c = 0; c < n_; c++)
+        hp_.col(r * n_ + c) %= inv_diag_.col(r);
+      inovation_.col(r) %= inv_diag_.col(r);
+    }
+    if (!missing.is_empty())
+      hp_.rows(missing).zeros();
+
+    // x + W^T L^-1 z and P - W^T W
+    for (arma::uword c = 0; c < n_; c++)
+      for (arma::uword r = 0; r < m_; r++)
+        means_.col(c) += hp_.col(r * n_ + c) % inovation_.col(r);
+    for (arma::uword j = 0; j < n_; j++)
+      for (arma::uword i = 0; i <= j; i++)
+        for (arma::uword r = 0; r < m_; r++)
+          covs_.col(sym(i, j)) -= hp_.col(r * n_ + i) % hp_.col(r * n_ + j);
+  }
+
+  //! Returns the means, row \f$t\f$ is the mean of track \f$t\f$
+  const arma::mat &getMeans() const { return means_; }
+
+  //! Returns the mean of a track
+  arma::vec getMean(arma::uword track) const {
+    return means_.row(track).t();
+  }
+
+  //! Returns the covariance of a track
+  arma::mat getCovariance(arma::uword track) const {
+    arma::mat covariance(n_, n_);
+    for (arma::uword j = 0; j < n_; j++)
+      for (arma::uword i = 0; i < n_; i++)
+        covariance(i, j) = covs_(track, sym(i, j));
+    return covariance;
+  }
+
+  //! Returns number of tracks \f$N\f$
+  arma::uword getNumTracks() const { return num_; }
+};
+
+template <class STA_MAP, class OBS_MAP>
+KalmanBank<STA_MAP, OBS_MAP> makeKalmanBank(
+    Hierarchical<Markov<Gaussian, STA_MAP, Gaussian>,
+                 Memoryless<Gaussian, OBS_MAP>> process,
+    arma::uword num_tracks) {
+  return KalmanBank<STA_MAP, OBS_MAP>(process, num_tracks);
+}
+
+} // namespace filter
+} // namespace ssmkit
+
+#endif // SSMPACK_FILTER_KALMAN_BANK_HPP
@@ -15,6 +15,8 @@
 #include <armadillo>
 
 #include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace ssmkit {
 namespace filter {
@@ -24,6 +26,26 @@ using process::Markov;
 using process::Memoryless;
 using distribution::Conditional;
 
+/// @cond DEV
+namespace detail {
+/* true if the pdf samples a block of points with random(arma::mat &) and
+ * scores it with likelihoodBatch(const arma::mat &), see
+ * distribution::Gaussian
+ */
+template <class TPDF, class = void>
+struct HasBatchPDF : std::false_type {};
+
+template <class TPDF>
+struct HasBatchPDF<
+    TPDF, typename distribution::detail::Void<
+              decltype(std::declval<TPDF &>().random(
+                  std::declval<arma::mat &>())),
+              decltype(std::declval<TPDF &>().likelihoodBatch(
+                  std::declval<const arma::mat &>()))>::type>
+    : std::true_type {};
+} // namespace detail
+/// @endcond
+
 /** Particle Filter.
  */
 template <class Process, class Resampler>
@@ -51,6 +73,25 @@ class Particle : public RecursiveBayesianBase<Particle<Process, Resampler>> {
   //! Normalizes the sum of weights to one
   void normalizeWeights(void) { w_ = w_ / arma::sum(w_); }
 
+  // sample and weight the initial particles as one block
+  template <class TPDF>
+  void initializeParticles(TPDF &initial_pdf, std::true_type) {
+    initial_pdf.random(state_par_);
+    w_ = initial_pdf.likelihoodBatch(state_par_);
+  }
+
+  // any pdf with random() and likelihood(), one particle at a time
+  template <class TPDF>
+  void initializeParticles(TPDF &initial_pdf, std::false_type) {
+    state_par_.each_col(
+        [&initial_pdf](arma::vec &v) { v = initial_pdf.random(); });
+
+    unsigned long cnt = 0;
+    w_.for_each([this, &initial_pdf, &cnt](double &e) {
+      e = initial_pdf.likelihood(state_par_.col(cnt++));
+    });
+  }
+
  public:
   /** Constructor
    *
@@ -78,9 +119,9 @@ class Particle : public RecursiveBayesianBase<Particle<Process, Resampler>> {
    */
   template <class... Args>
   void predict(const Args &... args) {
-    state_par_.each_col([this, &args...](arma::vec &v, const Args &... args) {
-      v = process_.template getProcess<0>().getCPDF().random(v, args...);
-    });
+    // all the particles are propagated as one block
+    state_par_ =
+        process_.template getProcess<0>().getCPDF().random(state_par_, args...);
   }
   /** Correction
    *
@@ -115,15 +156,10 @@ class Particle : public RecursiveBayesianBase<Particle<Process, Resampler>> {
    * @return Estimated state \f$\{\tilde{\mathbf{x}}^{(i)}_0,\tilde{\omega}^{(i)}\}_{i=1}^{M}\f$
    */
   CompeleteState initialize() {
-    state_par_.each_col([this](arma::vec &v) {
-      v = process_.template getProcess<0>().getInitialPDF().random();
-    });
-
-    unsigned long cnt = 0;
-    w_.for_each([this, &cnt](double &e) {
-      e = process_.template getProcess<0>().getInitialPDF().likelihood(
-          state_par_.col(cnt++));
-    });
+    auto &initial_pdf = process_.template getProcess<0>().getInitialPDF();
+    initializeParticles(
+        initial_pdf,
+        detail::HasBatchPDF<std::remove_reference_t<decltype(initial_pdf)>>());
 
     normalizeWeights();
 
@@ -12,13 +12,19 @@
 
 #include <armadillo>
 
+#include <functional>
 #include <random>
+#include <utility>
 
 namespace ssmkit {
 namespace filter {
 namespace resampler {
 
 /** Implements systematic resampling method
+ *
+ * The offset \f$u_0 \sim \mathcal{U}[0, 1)\f$ is drawn from
+ * random::Generator, or from a user given uniform source, e.g. a one
+ * dimensional random::Sobol sequence.
  */
 template <class Criterion>
 class Systematic : public BaseResampler<Systematic<Criterion>> {
@@ -26,10 +32,13 @@ class Systematic : public BaseResampler<Systematic<Criterion>> {
 
  private:
   std::uniform_real_distribution<double> uniform_;
+  //! Optional source of the offset, random::Generator is used if empty.
+  std::function<double()> source_;
 
  protected:
   arma::vec generateOrderedNumbers(const int &num_par) {
-    double u0 = uniform_(random::Generator::get().getGenerator());
+    double u0 = source_ ? source_()
+                        : uniform_(random::Generator::get().getGenerator());
     arma::vec u(num_par);
     int k = 0;
     u.imbue([&u0, &num_par, &k]() { return (k++ + u0) / num_par; });
@@ -39,6 +48,13 @@ class Systematic : public BaseResampler<Systematic<Criterion>> {
  public:
   Systematic(Criterion criterion)
       : BaseResampler<Systematic<Criterion>>(criterion) {}
+  /** Constructor with a uniform source
+   * @param criterion Resampling criterion.
+   * @param source Callable returning a number in \f$[0, 1)\f$.
+   */
+  Systematic(Criterion criterion, std::function<double()> source)
+      : BaseResampler<Systematic<Criterion>>(criterion),
+        source_(std::move(source)) {}
 };
 
 template<class Criterion>
@@ -46,6 +62,12 @@ Systematic<Criterion> makeSystematic(Criterion criterion){
   return Systematic<Criterion>(criterion);
 }
 
+template<class Criterion>
+Systematic<Criterion> makeSystematic(Criterion criterion,
+                                     std::function<double()> source){
+  return Systematic<Criterion>(criterion, std::move(source));
+}
+
 } // namespace resampler
 } // namespace filter
 } // namespace ssmkit
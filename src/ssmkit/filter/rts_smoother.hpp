@@ -0,0 +1,242 @@
+/**
+ * @file rts_smoother.hpp
+ * @author Vahid Bastani
+ *
+ * Implementation of Rauch-Tung-Striebel smoother
+ */
+#ifndef SSMPACK_FILTER_RTS_SMOOTHER_HPP
+#define SSMPACK_FILTER_RTS_SMOOTHER_HPP
+
+#include "ssmkit/filter/kalman.hpp"
+#include <armadillo>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ssmkit {
+namespace filter {
+
+/** Rauch-Tung-Striebel smoother
+ *
+ * Runs a filter::Kalman forward and keeps the moments which the backward
+ * pass needs. At every step the smoother gain
+ * \f{equation}{\mathbf{G}_{t-1} = \mathbf{P}_{t-1|t-1}\mathbf{F}^T
+ * \mathbf{P}_{t|t-1}^{-1}\f}
+ * is computed with the transition matrix of that step, so time-varying
+ * maps and controls are supported, and the backward pass
+ * \f{equation}{\hat{\mathbf{x}}_{t|T} = \hat{\mathbf{x}}_{t|t} +
+ * \mathbf{G}_t(\hat{\mathbf{x}}_{t+1|T} - \hat{\mathbf{x}}_{t+1|t})\f}
+ * \f{equation}{\mathbf{P}_{t|T} = \mathbf{P}_{t|t} +
+ * \mathbf{G}_t(\mathbf{P}_{t+1|T} - \mathbf{P}_{t+1|t})\mathbf{G}_t^T\f}
+ * only reads the stored moments.
+ *
+ * With zero lag the smoother is a fixed-interval smoother: the moments of
+ * the whole sequence are stored in contiguous buffers, which can be
+ * preallocated by reserve(), and smooth() overwrites the filtered moments
+ * with the smoothed ones. With a positive lag \f$L\f$ it is a fixed-lag
+ * smoother for streams: the buffers are rings of \f$L+1\f$ steps and every
+ * step gives \f$(\hat{\mathbf{x}}_{t-L|t}, \mathbf{P}_{t-L|t})\f$, so the
+ * memory does not grow with the length of the stream.
+ */
+template <class STA_MAP, class OBS_MAP>
+class RTSSmoother {
+
+ public:
+  //! Type of process object
+  using TProcess = typename Kalman<STA_MAP, OBS_MAP>::TProcess;
+
+ private:
+  //! The forward filter
+  Kalman<STA_MAP, OBS_MAP> kalman_;
+  //! The lag \f$L\f$, zero for fixed-interval smoothing
+  arma::uword lag_;
+  //! Number of stored steps, including the initial state
+  arma::uword length_ = 0;
+  //! Filtered (smoothed after smooth()) means, one column per step
+  arma::mat means_;
+  //! Filtered (smoothed after smooth()) covariances, one slice per step
+  arma::cube covs_;
+  //! Predicted means \f$\hat{\mathbf{x}}_{t|t-1}\f$
+  arma::mat p_means_;
+  //! Predicted covariances \f$\mathbf{P}_{t|t-1}\f$
+  arma::cube p_covs_;
+  //! Smoother gains, slice \f$t\f$ holds \f$\mathbf{G}_{t-1}\f$
+  arma::cube gains_;
+  //! \f$\mathbf{F}\mathbf{P}_{t-1|t-1}\f$ of the last step
+  arma::mat fp_;
+  //! The smoothed moments of the last fixed-lag step
+  arma::vec lag_mean_;
+  arma::mat lag_cov_;
+
+  // buffer index of a step, the buffers are rings in fixed-lag mode
+  arma::uword slot(arma::uword t) const { return lag_ ? t % (lag_ + 1) : t; }
+
+  // buffer index of a stored step, throws if it is not or no longer stored
+  arma::uword storedSlot(arma::uword t) const {
+    if (t >= length_ || (lag_ && t + lag_ + 1 < length_))
+      throw std::out_of_range("RTSSmoother: step " + std::to_string(t) +
+                              " is not stored");
+    return slot(t);
+  }
+
+  void grow(arma::uword capacity) {
+    const arma::uword n = kalman_.getStateVector().n_elem;
+    means_.resize(n, capacity);
+    covs_.resize(n, n, capacity);
+    p_means_.resize(n, capacity);
+    p_covs_.resize(n, n, capacity);
+    gains_.resize(n, n, capacity);
+  }
+
+  void store(arma::uword t) {
+    means_.col(slot(t)) = kalman_.getStateVector();
+    covs_.slice(slot(t)) = kalman_.getStateCovariance();
+  }
+
+  // one backward step from the smoothed moments of t + 1 to those of t
+  void backward(arma::uword t, arma::vec &mean, arma::mat &cov) const {
+    const arma::mat &gain = gains_.slice(slot(t + 1));
+    mean = means_.col(slot(t)) + gain * (mean - p_means_.col(slot(t + 1)));
+    cov = covs_.slice(slot(t)) +
+          gain * (cov - p_covs_.slice(slot(t + 1))) * gain.t();
+    cov = arma::symmatu(cov);
+  }
+
+ public:
+  /** Constructor
+   *
+   * @param process The process model, see filter::Kalman.
+   * @param lag The lag \f$L\f$ of the fixed-lag mode, zero for
+   * fixed-interval smoothing.
+   */
+  RTSSmoother(const TProcess &process, arma::uword lag = 0)
+      : kalman_(process), lag_(lag) {}
+
+  /** Preallocates the buffers of the fixed-interval mode for \p length
+   * steps; without it the buffers grow geometrically.
+   */
+  void reserve(arma::uword length) {
+    if (!lag_ && length + 1 > means_.n_cols)
+      grow(length + 1);
+  }
+
+  /** Starts a new sequence with the initial state of the process.
+   */
+  void initialize() {
+    kalman_.initialize();
+    length_ = 0;
+    const arma::uword n = kalman_.getStateVector().n_elem;
+    if (means_.n_cols == 0 || means_.n_rows != n)
+      grow(lag_ ? lag_ + 1 : 16);
+    store(length_++);
+  }
+
+  /** Filters one measurement and stores its moments.
+   *
+   * @param measurement Measurement vector \f$\mathbf{z}_t\f$.
+   * @param args... Control variables of the dynamic process, if any.
+   * @return In fixed-lag mode, true if the smoothed estimate of step
+   * \f$t-L\f$ is available by getLaggedMean() and getLaggedCovariance();
+   * always false in fixed-interval mode.
+   */
+  template <class... TArgs>
+  bool step(const arma::vec &measurement, const TArgs &... args) {
+    if (length_ == 0)
+      throw std::logic_error("RTSSmoother::step(): called before initialize()");
+    const arma::uword t = length_++;
+    if (!lag_ && t >= means_.n_cols)
+      grow(2 * means_.n_cols);
+
+    kalman_.predict(args...);
+    const arma::mat &p_cov = kalman_.getPredictedStateCovariance();
+    // G = P F^T Pp^-1, i.e. the transpose of Pp^-1 F P, with F of this step
+    detail::transferProduct(
+        fp_, detail::stepModel(kalman_.getDynamicMap(), args...),
+        covs_.slice(slot(t - 1)));
+    gains_.slice(slot(t)) = arma::solve(p_cov, fp_).t();
+    p_means_.col(slot(t)) = kalman_.getPredictedStateVector();
+    p_covs_.slice(slot(t)) = p_cov;
+
+    kalman_.correctInPlace(measurement);
+    store(t);
+
+    if (!lag_ || t < lag_)
+      return false;
+    lag_mean_ = kalman_.getStateVector();
+    lag_cov_ = kalman_.getStateCovariance();
+    for (arma::uword k = t; k > t - lag_; k--)
+      backward(k - 1, lag_mean_, lag_cov_);
+    return true;
+  }
+
+  /** Runs the backward pass of the fixed-interval mode in place, after it
+   * getMean() and getCovariance() return the smoothed moments
+   * \f$(\hat{\mathbf{x}}_{t|T}, \mathbf{P}_{t|T})\f$.
+   *
+   * @throw std::logic_error in fixed-lag mode, which keeps only the last
+   * steps, or before initialize().
+   */
+  void smooth() {
+    if (lag_ != 0)
+      throw std::logic_error(
+          "RTSSmoother::smooth(): not available in fixed-lag mode");
+    if (length_ == 0)
+      throw std::logic_error("RTSSmoother::smooth(): called before initialize()");
+    arma::vec mean;
+    arma::mat cov;
+    for (arma::uword t = length_ - 1; t > 0; t--) {
+      mean = means_.col(t);
+      cov = covs_.slice(t);
+      backward(t - 1, mean, cov);
+      means_.col(t - 1) = mean;
+      covs_.slice(t - 1) = cov;
+    }
+  }
+
+  /** Filters and smooths a sequence of measurements in the fixed-interval
+   * mode.
+   */
+  void smooth(const std::vector<arma::vec> &measurements) {
+    reserve(measurements.size());
+    initialize();
+    for (const auto &measurement : measurements)
+      step(measurement);
+    smooth();
+  }
+
+  /** Returns the mean of step \p t, step zero is the initial state.
+   * @throw std::out_of_range if the step is not stored, in fixed-lag mode
+   * only the last \f$L+1\f$ steps are.
+   */
+  arma::vec getMean(arma::uword t) const { return means_.col(storedSlot(t)); }
+
+  /** Returns the covariance of step \p t, step zero is the initial state.
+   * @throw std::out_of_range if the step is not stored, see getMean().
+   */
+  const arma::mat &getCovariance(arma::uword t) const {
+    return covs_.slice(storedSlot(t));
+  }
+
+  //! Returns number of stored steps, including the initial state
+  arma::uword size() const { return length_; }
+
+  //! Returns the smoothed mean \f$\hat{\mathbf{x}}_{t-L|t}\f$ of the last step
+  const arma::vec &getLaggedMean() const { return lag_mean_; }
+
+  //! Returns the smoothed covariance \f$\mathbf{P}_{t-L|t}\f$ of the last step
+  const arma::mat &getLaggedCovariance() const { return lag_cov_; }
+};
+
+template <class STA_MAP, class OBS_MAP>
+RTSSmoother<STA_MAP, OBS_MAP> makeRTSSmoother(
+    Hierarchical<Markov<Gaussian, STA_MAP, Gaussian>,
+                 Memoryless<Gaussian, OBS_MAP>> process,
+    arma::uword lag = 0) {
+  return RTSSmoother<STA_MAP, OBS_MAP>(process, lag);
+}
+
+} // namespace filter
+} // namespace ssmkit
+
+#endif // SSMPACK_FILTER_RTS_SMOOTHER_HPP
@@ -0,0 +1,266 @@
+/**
+ * @file square_root_kalman.hpp
+ * @author Vahid Bastani
+ *
+ * Implementation of square-root Kalman filter
+ */
+#ifndef SSMPACK_FILTER_SQUARE_ROOT_KALMAN_HPP
+#define SSMPACK_FILTER_SQUARE_ROOT_KALMAN_HPP
+
+#include "ssmkit/distribution/gaussian.hpp"
+#include "ssmkit/distribution/conditional.hpp"
+#include "ssmkit/process/markov.hpp"
+#include "ssmkit/process/memoryless.hpp"
+#include "ssmkit/process/hierarchical.hpp"
+#include "ssmkit/filter/recursive_bayesian_base.hpp"
+#include <armadillo>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+
+namespace ssmkit {
+namespace filter {
+
+using process::Hierarchical;
+using process::Markov;
+using process::Memoryless;
+using distribution::Conditional;
+using distribution::Gaussian;
+
+/** Square-root Kalman filter
+ *
+ * Same model and interface as filter::Kalman, but the state covariance is
+ * propagated as its lower Cholesky factor \f$\mathbf{P} = \mathbf{S}\mathbf{S}^T\f$.
+ * Both steps triangularize a pre-array by a QR decomposition and the gain is
+ * applied by triangular solves, so the covariance stays symmetric positive
+ * semi-definite over long runs and no inverse is formed.
+ *
+ * As for filter::Kalman, \f$\mathbf{Q}\f$, \f$\mathbf{R}\f$ and
+ * \f$\mathbf{P}_{0|0}\f$ may be singular positive semi-definite, e.g. noise
+ * driving only some of the states; only the innovation covariance should be
+ * positive definite.
+ *
+ * The pre-arrays are kept in a workspace owned by the filter and are
+ * triangularized in place by LAPACK, only the triangular factor is computed
+ * and the orthogonal one is never formed. The means are written by the
+ * \a mean method of the maps if they have one (see map::LinearGaussian::mean).
+ * The covariance \f$\mathbf{S}\mathbf{S}^T\f$ is formed only when it is
+ * requested, by correct() or getStateCovariance(); correctInPlace() is the
+ * same step without it.
+ */
+template <class STA_MAP, class OBS_MAP>
+class SquareRootKalman
+    : public RecursiveBayesianBase<SquareRootKalman<STA_MAP, OBS_MAP>> {
+
+ public:
+  //! Type of process object
+  using TProcess =
+      Hierarchical<Markov<Gaussian, STA_MAP, Gaussian>,
+                   Memoryless<Gaussian, OBS_MAP>>;
+  //! Type of the posterior state \f$(\hat{\mathbf{x}}, \hat{\mathbf{P}})\f$
+  using TCompeleteState =
+      std::tuple<arma::vec, arma::mat>;
+
+ private:
+  //! The process object
+  TProcess process_;
+  //! The dynamic map holding the state transition matrix \f$\mathbf{F}\f$
+  const STA_MAP &dyn_map_;
+  //! The measurement map holding the measurement matrix \f$\mathbf{H}\f$
+  const OBS_MAP &mes_map_;
+  //! The covariance of dynamic noise \f$\mathbf{Q}\f$
+  const arma::mat &dyn_cov_;
+  //! The covariance of measurement noise \f$\mathbf{R}\f$
+  const arma::mat &mes_cov_;
+  //! The factorized \f$\mathbf{Q}\f$ and its square root
+  arma::mat dyn_cov_copy_, dyn_cov_factor_;
+  //! The factorized \f$\mathbf{R}\f$ and its square root
+  arma::mat mes_cov_copy_, mes_cov_factor_;
+  //! The corrected state vector \f$\mathbf{x}_{t|t}\f$
+  arma::vec state_vec_;
+  //! The factor of the corrected state covariance \f$\mathbf{S}_{t|t}\f$
+  arma::mat state_factor_;
+  //! The predicted state vector \f$\mathbf{x}_{t|t-1}\f$
+  arma::vec p_state_vec_;
+  //! The factor of the predicted state covariance \f$\mathbf{S}_{t|t-1}\f$
+  arma::mat p_state_factor_;
+  // workspace of a step, kept between the steps to avoid allocations
+  arma::vec mes_mean_, inovation_, w_inovation_, tau_, qr_work_;
+  arma::mat pre_array_, product_, inovation_factor_;
+
+  /* a square root S S^T = cov of a positive semi-definite matrix: the lower
+   * Cholesky factor if cov is positive definite, otherwise V D^1/2 of its
+   * eigendecomposition, where the negative eigenvalues are round-off of zero
+   * ones; the filter needs no triangular S, the QR steps triangularize it
+   */
+  static arma::mat squareRoot(const arma::mat &cov) {
+    arma::mat factor;
+    if (arma::chol(factor, cov, "lower"))
+      return factor;
+    arma::vec eigval;
+    arma::eig_sym(eigval, factor, cov);
+    for (arma::uword i = 0; i < eigval.n_elem; i++)
+      factor.col(i) *= eigval(i) > 0 ? std::sqrt(eigval(i)) : 0.0;
+    return factor;
+  }
+
+  // refactorizes a noise covariance only if it has changed since last time
+  static void updateFactor(const arma::mat &cov, arma::mat &copy,
+                           arma::mat &factor) {
+    if (cov.n_rows != copy.n_rows || cov.n_cols != copy.n_cols ||
+        !std::equal(cov.begin(), cov.end(), copy.begin())) {
+      copy = cov;
+      factor = squareRoot(cov);
+    }
+  }
+
+  /* QR decomposition of pre_array_ in place by LAPACK (dgeqrf): the upper
+   * triangle of its leading rows is R afterwards, Q is not formed
+   */
+  void triangularize() {
+    arma::blas_int m = pre_array_.n_rows, n = pre_array_.n_cols;
+    arma::blas_int lwork = 64 * std::max<arma::blas_int>(n, 1), info = 0;
+    tau_.set_size(std::min(pre_array_.n_rows, pre_array_.n_cols));
+    qr_work_.set_size(lwork);
+    arma::lapack::geqrf(&m, &n, pre_array_.memptr(), &m, tau_.memptr(),
+                        qr_work_.memptr(), &lwork, &info);
+    if (info != 0)
+      throw std::runtime_error(
+          "SquareRootKalman: QR decomposition of the pre-array failed");
+  }
+
+  // out = R^T of the n x n diagonal block of pre_array_ starting at first
+  void lowerFactor(arma::mat &out, arma::uword first, arma::uword n) const {
+    out.zeros(n, n);
+    for (arma::uword c = 0; c < n; c++)
+      for (arma::uword r = 0; r <= c; r++)
+        out.at(c, r) = pre_array_.at(first + r, first + c);
+  }
+
+ public:
+  /** Construct a square-root Kalman filter
+   *
+   * Construct a square-root Kalman filter with parameters taken from
+   * \p process argument.
+   */
+  SquareRootKalman(const TProcess &process)
+      : process_(process),
+        dyn_map_(process_.template getProcess<0>().getCPDF().getParamMap()),
+        mes_map_(process_.template getProcess<1>().getCPDF().getParamMap()),
+        dyn_cov_(dyn_map_.covariance), mes_cov_(mes_map_.covariance) {}
+
+  /** Prediction
+   *
+   * Performs the prediction step, \f$\mathbf{S}_{t|t-1}\f$ is the transposed
+   * triangular factor of the QR decomposition
+   * \f{equation}{\begin{bmatrix}(\mathbf{F}\mathbf{S}_{t-1|t-1})^T \\
+   * \mathbf{S}_Q^T\end{bmatrix} = \mathbf{Q}_r\mathbf{S}_{t|t-1}^T \f}
+   *
+   * @param args... Control variables of the dynamic process, if any.
+   */
+  template <class... TArgs>
+  void predict(const TArgs &... args) {
+    distribution::detail::mapMean(p_state_vec_, dyn_map_, state_vec_, args...);
+    updateFactor(dyn_cov_, dyn_cov_copy_, dyn_cov_factor_);
+
+    const arma::uword n = p_state_vec_.n_elem;
+    // (F S)^T = S^T F^T, the transposes are folded into the product
+    product_ = state_factor_.t() * dyn_map_.transfer.t();
+    pre_array_.set_size(2 * n, n);
+    pre_array_.rows(0, n - 1) = product_;
+    pre_array_.rows(n, 2 * n - 1) = dyn_cov_factor_.t();
+    triangularize();
+    lowerFactor(p_state_factor_, 0, n);
+  }
+
+  /** Correction
+   *
+   * Performs correction step by triangularizing the pre-array
+   * \f{equation}{\begin{bmatrix}\mathbf{S}_R & \mathbf{H}\mathbf{S}_{t|t-1} \\
+   * 0 & \mathbf{S}_{t|t-1}\end{bmatrix}\Theta =
+   * \begin{bmatrix}\mathbf{S}_e & 0 \\ \bar{\mathbf{K}}_t &
+   * \mathbf{S}_{t|t}\end{bmatrix}\f}
+   * where \f$\mathbf{S}_e\mathbf{S}_e^T\f$ is the innovation covariance and
+   * \f$\hat{\mathbf{x}}_{t|t}=\hat{\mathbf{x}}_{t|t-1}+\bar{\mathbf{K}}_t
+   * \mathbf{S}_e^{-1}\tilde{\mathbf{z}}_t\f$.
+   *
+   * @param measurement Measurement vector \f$\mathbf{z}_t\f$.
+   * @param args... Control variables of the measurement process, if any.
+   * @return Estimated state \f$(\hat{\mathbf{x}}_{t|t}, \mathbf{P}_{t|t})\f$
+   */
+  template <class... TArgs>
+  TCompeleteState correct(const arma::vec &measurement,
+                          const TArgs &... args) {
+    correctInPlace(measurement, args...);
+    return std::make_tuple(state_vec_, getStateCovariance());
+  }
+
+  /** Correction without returning the posterior.
+   *
+   * Performs the same correction step as correct(), the posterior is kept
+   * in the filter and read by getStateVector() and getCovarianceFactor().
+   *
+   * @param measurement Measurement vector \f$\mathbf{z}_t\f$.
+   * @param args... Control variables of the measurement process, if any.
+   */
+  template <class... TArgs>
+  void correctInPlace(const arma::vec &measurement, const TArgs &... args) {
+    distribution::detail::mapMean(mes_mean_, mes_map_, p_state_vec_, args...);
+    inovation_ = measurement;
+    inovation_ -= mes_mean_;
+    updateFactor(mes_cov_, mes_cov_copy_, mes_cov_factor_);
+
+    // the transposed pre-array [S_R^T 0; (H S)^T S^T] is triangularized
+    const arma::uword n = p_state_vec_.n_elem, m = inovation_.n_elem;
+    product_ = p_state_factor_.t() * mes_map_.transfer.t();
+    pre_array_.zeros(m + n, m + n);
+    pre_array_.submat(0, 0, m - 1, m - 1) = mes_cov_factor_.t();
+    pre_array_.submat(m, 0, m + n - 1, m - 1) = product_;
+    pre_array_.submat(m, m, m + n - 1, m + n - 1) = p_state_factor_.t();
+    triangularize();
+
+    // S_e^-1 z, then the gain K = R_12^T is applied from the array
+    lowerFactor(inovation_factor_, 0, m);
+    w_inovation_ = arma::solve(arma::trimatl(inovation_factor_), inovation_,
+                               arma::solve_opts::fast);
+    state_vec_ = p_state_vec_;
+    state_vec_ += pre_array_.submat(0, m, m - 1, m + n - 1).t() * w_inovation_;
+    lowerFactor(state_factor_, m, n);
+  }
+
+  /** Initialization
+   *
+   * @return Initial state \f$(\hat{\mathbf{x}}_{0|0}, \mathbf{P}_{0|0})\f$
+   */
+  TCompeleteState initialize() {
+    const Gaussian &initial = process_.template getProcess<0>().getInitialPDF();
+    state_vec_ = initial.getMean();
+    state_factor_ = squareRoot(initial.getCovariance());
+    return std::make_tuple(state_vec_, initial.getCovariance());
+  }
+
+  //! Returns the corrected state vector \f$\hat{\mathbf{x}}_{t|t}\f$
+  const arma::vec &getStateVector() const { return state_vec_; }
+
+  //! Returns the corrected state covariance \f$\mathbf{S}_{t|t}\mathbf{S}_{t|t}^T\f$, formed per call
+  arma::mat getStateCovariance() const {
+    return state_factor_ * state_factor_.t();
+  }
+
+  //! Returns the factor of the corrected state covariance \f$\mathbf{S}_{t|t}\f$
+  const arma::mat &getCovarianceFactor() const { return state_factor_; }
+};
+
+template <class STA_MAP, class OBS_MAP>
+SquareRootKalman<STA_MAP, OBS_MAP> makeSquareRootKalman(
+    Hierarchical<Markov<Gaussian, STA_MAP, Gaussian>,
+                 Memoryless<Gaussian, OBS_MAP>> process) {
+  return SquareRootKalman<STA_MAP, OBS_MAP>(process);
+}
+
+} // namespace filter
+} // namespace ssmkit
+
+#endif // SSMPACK_FILTER_SQUARE_ROOT_KALMAN_HPP
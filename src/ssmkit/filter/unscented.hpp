@@ -0,0 +1,250 @@
+/**
+ * @file unscented.hpp
+ * @author Vahid Bastani
+ *
+ * Implementation of unscented Kalman filter
+ */
+#ifndef SSMPACK_FILTER_UNSCENTED_HPP
+#define SSMPACK_FILTER_UNSCENTED_HPP
+
+#include "ssmkit/distribution/gaussian.hpp"
+#include "ssmkit/distribution/conditional.hpp"
+#include "ssmkit/process/markov.hpp"
+#include "ssmkit/process/memoryless.hpp"
+#include "ssmkit/process/hierarchical.hpp"
+#include "ssmkit/filter/recursive_bayesian_base.hpp"
+#include <armadillo>
+
+#include <cmath>
+#include <tuple>
+#include <type_traits>
+
+namespace ssmkit {
+namespace filter {
+
+using process::Hierarchical;
+using process::Markov;
+using process::Memoryless;
+using distribution::Conditional;
+using distribution::Gaussian;
+
+/** Unscented Kalman filter
+ *
+ * Filters a process with Gaussian conditionals whose parameter maps may be
+ * any (nonlinear) function \f$(\mathbf{\mu}, \mathbf{\Sigma}) =
+ * g(\mathbf{x}, \cdots)\f$. The noise is taken as additive, with the
+ * covariance given by the map. The state distribution is represented by
+ * \f$2n+1\f$ sigma points
+ * \f{equation}{\mathcal{X}_0 = \hat{\mathbf{x}}, \quad
+ * \mathcal{X}_{i}, \mathcal{X}_{n+i} = \hat{\mathbf{x}} \pm
+ * \sqrt{n+\lambda}\,[\mathbf{S}]_i, \quad \mathbf{P} = \mathbf{S}\mathbf{S}^T,
+ * \quad \lambda = \alpha^2(n+\kappa)-n\f}
+ * kept as the columns of one matrix. If the map provides a \a batch method
+ * (e.g. map::LinearGaussian) all the points are mapped by one call,
+ * otherwise they are mapped one by one.
+ */
+template <class STA_MAP, class OBS_MAP>
+class Unscented
+    : public RecursiveBayesianBase<Unscented<STA_MAP, OBS_MAP>> {
+
+ public:
+  //! Type of process object
+  using TProcess =
+      Hierarchical<Markov<Gaussian, STA_MAP, Gaussian>,
+                   Memoryless<Gaussian, OBS_MAP>>;
+  //! Type of the posterior state \f$(\hat{\mathbf{x}}, \hat{\mathbf{P}})\f$
+  using TCompeleteState =
+      std::tuple<arma::vec, arma::mat>;
+
+ private:
+  //! The process object
+  TProcess process_;
+  //! The dynamic map \f$f(\mathbf{x}, \cdots)\f$
+  const STA_MAP &dyn_map_;
+  //! The measurement map \f$h(\mathbf{x}, \cdots)\f$
+  const OBS_MAP &mes_map_;
+  //! Spread of the sigma points \f$\alpha\f$
+  double alpha_;
+  //! Prior knowledge of the distribution \f$\beta\f$, 2 for Gaussian
+  double beta_;
+  //! Secondary scaling \f$\kappa\f$
+  double kappa_;
+  //! Weights of the means and of the covariances
+  arma::rowvec mean_weights_, cov_weights_;
+  //! The corrected state vector \f$\mathbf{x}_{t|t}\f$
+  arma::vec state_vec_;
+  //! The corrected state covariance \f$\mathbf{P}_{t|t}\f$
+  arma::mat state_cov_;
+  //! The predicted state vector \f$\mathbf{x}_{t|t-1}\f$
+  arma::vec p_state_vec_;
+  //! The predicted state covariance \f$\mathbf{P}_{t|t-1}\f$
+  arma::mat p_state_cov_;
+  // workspace: sigma points, mapped points, their deviations and the noise
+  arma::mat points_, mapped_, deviations_, noise_cov_;
+
+  void computeWeights(arma::uword n) {
+    if (mean_weights_.n_elem == 2 * n + 1)
+      return;
+    const double lambda = alpha_ * alpha_ * (n + kappa_) - n;
+    mean_weights_.set_size(2 * n + 1);
+    mean_weights_.fill(0.5 / (n + lambda));
+    mean_weights_(0) = lambda / (n + lambda);
+    cov_weights_ = mean_weights_;
+    cov_weights_(0) += 1 - alpha_ * alpha_ + beta_;
+  }
+
+  // sigma points of N(mean, cov) in the columns of points_
+  void sigmaPoints(const arma::vec &mean, const arma::mat &cov) {
+    const arma::uword n = mean.n_elem;
+    computeWeights(n);
+    const double lambda = alpha_ * alpha_ * (n + kappa_) - n;
+    const arma::mat spread = std::sqrt(n + lambda) * arma::chol(cov, "lower");
+    points_.set_size(n, 2 * n + 1);
+    points_.cols(1, n) = spread;
+    points_.cols(n + 1, 2 * n) = -spread;
+    points_.each_col() += mean;
+    points_.col(0) = mean;
+  }
+
+  // maps all the points at once if the map has a batch method
+  template <class TMap, class... TArgs>
+  void mapPoints(std::true_type, const TMap &map, const TArgs &... args) {
+    const auto &param = map.batch(points_, args...);
+    mapped_ = std::get<0>(param);
+    noise_cov_ = std::get<1>(param);
+  }
+
+  // maps the points one by one, the noise covariance is that of the center
+  template <class TMap, class... TArgs>
+  void mapPoints(std::false_type, const TMap &map, const TArgs &... args) {
+    for (arma::uword i = 0; i < points_.n_cols; i++) {
+      const auto &param = map(arma::vec(points_.col(i)), args...);
+      const arma::vec &mean = std::get<0>(param);
+      if (i == 0) {
+        mapped_.set_size(mean.n_elem, points_.n_cols);
+        noise_cov_ = std::get<1>(param);
+      }
+      mapped_.col(i) = mean;
+    }
+  }
+
+  template <class TMap, class... TArgs>
+  void transform(const TMap &map, const TArgs &... args) {
+    mapPoints(distribution::detail::HasBatchMap<TMap, std::tuple<TArgs...>>(),
+              map, args...);
+  }
+
+ public:
+  /** Construct an unscented Kalman filter
+   *
+   * Construct an unscented Kalman filter with parameters taken from
+   * \p process argument.
+   *
+   * @param process The process model.
+   * @param alpha Spread of the sigma points around the mean, \f$0 < \alpha
+   * \leq 1\f$.
+   * @param beta Prior knowledge of the distribution, 2 is optimal for
+   * Gaussian.
+   * @param kappa Secondary scaling parameter.
+   */
+  Unscented(const TProcess &process, double alpha = 1, double beta = 2,
+            double kappa = 0)
+      : process_(process),
+        dyn_map_(process_.template getProcess<0>().getCPDF().getParamMap()),
+        mes_map_(process_.template getProcess<1>().getCPDF().getParamMap()),
+        alpha_(alpha), beta_(beta), kappa_(kappa) {}
+
+  /** Prediction
+   *
+   * Maps the sigma points of the corrected state by the dynamic map.
+   * \f{equation}{\hat{\mathbf{x}}_{t|t-1} = \sum_i W^m_i f(\mathcal{X}_i)\f}
+   * \f{equation}{\mathbf{P}_{t|t-1} = \sum_i W^c_i
+   * (f(\mathcal{X}_i) - \hat{\mathbf{x}}_{t|t-1})
+   * (f(\mathcal{X}_i) - \hat{\mathbf{x}}_{t|t-1})^T + \mathbf{Q}\f}
+   *
+   * @param args... Control variables of the dynamic process, if any.
+   */
+  template <class... TArgs>
+  void predict(const TArgs &... args) {
+    sigmaPoints(state_vec_, state_cov_);
+    transform(dyn_map_, args...);
+    p_state_vec_ = mapped_ * mean_weights_.t();
+    deviations_ = mapped_.each_col() - p_state_vec_;
+    p_state_cov_ = (deviations_.each_row() % cov_weights_) * deviations_.t() +
+                   noise_cov_;
+    p_state_cov_ = arma::symmatu(p_state_cov_);
+  }
+
+  /** Correction
+   *
+   * Maps the sigma points of the predicted state by the measurement map,
+   * with \f$\mathcal{Z}_i = h(\mathcal{X}_i)\f$
+   * \f{equation}{\mathbf{S}_t = \sum_i W^c_i (\mathcal{Z}_i - \hat{\mathbf{z}})
+   * (\mathcal{Z}_i - \hat{\mathbf{z}})^T + \mathbf{R}, \quad
+   * \mathbf{C}_t = \sum_i W^c_i (\mathcal{X}_i - \hat{\mathbf{x}}_{t|t-1})
+   * (\mathcal{Z}_i - \hat{\mathbf{z}})^T\f}
+   * \f{equation}{\mathbf{K}_t = \mathbf{C}_t\mathbf{S}_t^{-1}, \quad
+   * \hat{\mathbf{x}}_{t|t} = \hat{\mathbf{x}}_{t|t-1} +
+   * \mathbf{K}_t(\mathbf{z}_t - \hat{\mathbf{z}}), \quad
+   * \mathbf{P}_{t|t} = \mathbf{P}_{t|t-1} -
+   * \mathbf{K}_t\mathbf{S}_t\mathbf{K}_t^T\f}
+   *
+   * @param measurement Measurement vector \f$\mathbf{z}_t\f$.
+   * @param args... Control variables of the measurement process, if any.
+   * @return Estimated state \f$(\hat{\mathbf{x}}_{t|t}, \mathbf{P}_{t|t})\f$
+   */
+  template <class... TArgs>
+  TCompeleteState correct(const arma::vec &measurement,
+                          const TArgs &... args) {
+    sigmaPoints(p_state_vec_, p_state_cov_);
+    transform(mes_map_, args...);
+    const arma::vec mes_mean = mapped_ * mean_weights_.t();
+    arma::mat weighted = points_.each_col() - p_state_vec_;
+    weighted.each_row() %= cov_weights_;
+    deviations_ = mapped_.each_col() - mes_mean;
+    const arma::mat inovation_cov =
+        arma::symmatu((deviations_.each_row() % cov_weights_) *
+                          deviations_.t() +
+                      noise_cov_);
+    // K = C S^-1, i.e. the transpose of S^-1 C^T
+    const arma::mat kalman_gain =
+        arma::solve(inovation_cov, deviations_ * weighted.t()).t();
+
+    state_vec_ = p_state_vec_ + kalman_gain * (measurement - mes_mean);
+    state_cov_ = arma::symmatu(p_state_cov_ -
+                               kalman_gain * inovation_cov * kalman_gain.t());
+    return std::make_tuple(state_vec_, state_cov_);
+  }
+
+  /** Initialization
+   *
+   * @return Initial state \f$(\hat{\mathbf{x}}_{0|0}, \mathbf{P}_{0|0})\f$
+   */
+  TCompeleteState initialize() {
+    state_vec_ = process_.template getProcess<0>().getInitialPDF().getMean();
+    state_cov_ =
+        process_.template getProcess<0>().getInitialPDF().getCovariance();
+    return std::make_tuple(state_vec_, state_cov_);
+  }
+
+  //! Returns the predicted state vector \f$\hat{\mathbf{x}}_{t|t-1}\f$
+  const arma::vec &getPredictedStateVector() const { return p_state_vec_; }
+
+  //! Returns the predicted state covariance \f$\mathbf{P}_{t|t-1}\f$
+  const arma::mat &getPredictedStateCovariance() const {
+    return p_state_cov_;
+  }
+};
+
+template <class STA_MAP, class OBS_MAP>
+Unscented<STA_MAP, OBS_MAP> makeUnscented(
+    Hierarchical<Markov<Gaussian, STA_MAP, Gaussian>,
+                 Memoryless<Gaussian, OBS_MAP>> process,
+    double alpha = 1, double beta = 2, double kappa = 0) {
+  return Unscented<STA_MAP, OBS_MAP>(process, alpha, beta, kappa);
+}
+
+} // namespace filter
+} // namespace ssmkit
+
+#endif // SSMPACK_FILTER_UNSCENTED_HPP
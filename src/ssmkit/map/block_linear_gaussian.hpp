@@ -0,0 +1,96 @@
+#ifndef SSMPACK_MODEL_BLOCK_LINEAR_GAUSSIAN_HPP
+#define SSMPACK_MODEL_BLOCK_LINEAR_GAUSSIAN_HPP
+
+#include <armadillo>
+
+#include <tuple>
+#include <utility>
+
+namespace ssmkit {
+namespace map {
+
+/** Computes \f$(I_N \otimes A) M\f$ without forming the Kronecker product.
+ *
+ * Every column of \p m is split into \p n consecutive chunks of
+ * \f$A\f$.n_cols elements which are all mapped by one matrix product, so the
+ * cost is linear in \p n. The chunks are gathered by one reshaping copy of
+ * \p m, which is cheap next to the product.
+ *
+ * @param[out] out The product, resized to \f$N\f$ times \f$A\f$.n_rows rows.
+ * @param a The block \f$A\f$.
+ * @param n Number of blocks \f$N\f$.
+ * @param m Matrix with \f$N\f$ times \f$A\f$.n_cols rows.
+ */
+inline void blockMultiply(arma::mat &out, const arma::mat &a, unsigned int n,
+                          const arma::mat &m) {
+  out.set_size(a.n_rows * n, m.n_cols);
+  // column-major storage: (N b) x K is the same memory as b x (N K)
+  arma::mat out_view(out.memptr(), a.n_rows, n * m.n_cols, false, true);
+  out_view = a * arma::reshape(m, a.n_cols, n * m.n_cols);
+}
+
+//! Returns \f$(I_N \otimes A) M\f$ in a newly allocated matrix.
+inline arma::mat blockMultiply(const arma::mat &a, unsigned int n,
+                               const arma::mat &m) {
+  arma::mat out;
+  blockMultiply(out, a, n, m);
+  return out;
+}
+
+/** Linear Gaussian map made of \f$N\f$ identical independent blocks.
+ * \f[ \mathbf{F} = I_N \otimes \mathbf{F}_b, \quad
+ * \mathbf{Q} = I_N \otimes \mathbf{Q}_b \f]
+ * e.g. the same constant-velocity model stacked for \f$N\f$ targets. Only
+ * the blocks are stored. The means are computed block-wise, and
+ * filter::Kalman uses the blocks to keep its covariance updates linear in
+ * \f$N\f$. The dense covariance is formed only when the parameters are
+ * requested by the call operator or batch(), e.g. for sampling; filters other
+ * than filter::Kalman and its smoother need the dense matrices of
+ * map::LinearGaussian.
+ */
+struct BlockLinearGaussian {
+  //! The dense covariance is formed per call, so unlike map::LinearGaussian it is a value
+  using TParameter = std::tuple<arma::vec, arma::mat>;
+  using TBatchParameter = std::tuple<arma::mat, arma::mat>;
+  using TConditionVAR = arma::vec;
+
+  BlockLinearGaussian(arma::mat block_trans, arma::mat block_cov,
+                      unsigned int num_blocks)
+      : block_transfer{block_trans}, block_covariance{block_cov},
+        blocks{num_blocks} {}
+  // should not be overloaded, should not be template
+  TParameter operator()(const TConditionVAR &x) const {
+    arma::vec mean;
+    this->mean(mean, x);
+    return std::make_tuple(std::move(mean), covariance());
+  }
+
+  //! Writes the mean into \p out, see map::LinearGaussian::mean
+  void mean(arma::vec &out, const TConditionVAR &x) const {
+    blockMultiply(out, block_transfer, blocks, x);
+  }
+
+  /** Parameters of a block of conditions, one condition per column of \p x.
+   */
+  TBatchParameter batch(const arma::mat &x) const {
+    return std::make_tuple(blockMultiply(block_transfer, blocks, x),
+                           covariance());
+  }
+
+  //! Returns the dense covariance \f$I_N \otimes \mathbf{Q}_b\f$
+  arma::mat covariance() const {
+    return arma::kron(arma::eye<arma::mat>(blocks, blocks), block_covariance);
+  }
+
+  //! The transfer matrix of one block \f$\mathbf{F}_b\f$
+  arma::mat block_transfer;
+  //! The covariance of one block \f$\mathbf{Q}_b\f$
+  arma::mat block_covariance;
+  //! Number of blocks \f$N\f$
+  unsigned int blocks;
+};
+
+} // namespace map
+} // namespace ssmkit
+
+#endif // SSMPACK_MODEL_BLOCK_LINEAR_GAUSSIAN_HPP
@@ -0,0 +1,135 @@
+#ifndef SSMPACK_MODEL_CONTINUOUS_LINEAR_GAUSSIAN_HPP
+#define SSMPACK_MODEL_CONTINUOUS_LINEAR_GAUSSIAN_HPP
+
+#include <armadillo>
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <tuple>
+#include <vector>
+
+namespace ssmkit {
+namespace map {
+
+/** Linear Gaussian map of a continuous-time model sampled at varying intervals.
+ *
+ * The model \f$d\mathbf{x} = \mathbf{A}\mathbf{x}dt + d\mathbf{w}\f$ with
+ * diffusion (spectral density) \f$\mathbf{Q}_c\f$ is discretized for the
+ * sample interval \f$\Delta t\f$ which is given as a control variable:
+ * \f[ \mathbf{F} = e^{\mathbf{A}\Delta t}, \quad
+ * \mathbf{Q} = \int_0^{\Delta t} e^{\mathbf{A}s}\mathbf{Q}_c
+ * e^{\mathbf{A}^Ts} ds \f]
+ * both computed with one matrix exponential (Van Loan's method). The
+ * discretizations of the last few distinct intervals are kept in a least
+ * recently used cache, so sensors with a handful of rates never repeat it.
+ *
+ * The map has no transfer matrix of its own, \f$\mathbf{F}\f$ and
+ * \f$\mathbf{Q}\f$ of an interval are read from discretization(), e.g. by
+ * filter::Kalman::predict(dt). The cache is updated by the const methods,
+ * thus a map should not be used by several threads at once. A
+ * discretization stays in place until it is evicted, i.e. at least until
+ * cache_size - 1 other intervals have been requested; a copy of the map
+ * has its own cache.
+ */
+struct ContinuousLinearGaussian {
+  //! The covariance refers to a cached \f$\mathbf{Q}\f$, see discretization()
+  using TParameter = std::tuple<arma::vec, const arma::mat &>;
+  using TBatchParameter = std::tuple<arma::mat, const arma::mat &>;
+  using TConditionVAR = arma::vec;
+
+  //! Discretization of one interval
+  struct Discretization {
+    //! The interval \f$\Delta t\f$
+    double dt;
+    //! The transfer matrix \f$\mathbf{F}\f$
+    arma::mat transfer;
+    //! The covariance \f$\mathbf{Q}\f$
+    arma::mat covariance;
+  };
+
+  /**
+   * @param drift_mat The drift matrix \f$\mathbf{A}\f$.
+   * @param diffusion_mat The diffusion matrix \f$\mathbf{Q}_c\f$.
+   * @param cache_size Number of cached discretizations.
+   */
+  ContinuousLinearGaussian(arma::mat drift_mat, arma::mat diffusion_mat,
+                           std::size_t cache_size = 8)
+      : drift{drift_mat}, diffusion{diffusion_mat},
+        cache_size_{std::max<std::size_t>(cache_size, 1)} {}
+  // should not be overloaded, should not be template
+  TParameter operator()(const TConditionVAR &x, const double &dt) const {
+    const Discretization &d = discretization(dt);
+    return TParameter(d.transfer * x, d.covariance);
+  }
+
+  //! Writes the mean into \p out, see map::LinearGaussian::mean
+  void mean(arma::vec &out, const TConditionVAR &x, const double &dt) const {
+    out = discretization(dt).transfer * x;
+  }
+
+  /** Parameters of a block of conditions, one condition per column of \p x.
+   * All the columns share the same interval \p dt.
+   */
+  TBatchParameter batch(const arma::mat &x, const double &dt) const {
+    const Discretization &d = discretization(dt);
+    return TBatchParameter(d.transfer * x, d.covariance);
+  }
+
+  /** Returns \f$\mathbf{F}\f$ and \f$\mathbf{Q}\f$ of the interval
+   * \p dt, computed on the first request and then taken from the cache.
+   */
+  const Discretization &discretization(double dt) const {
+    std::size_t oldest = 0;
+    for (std::size_t i = 0; i < cache_.size(); i++) {
+      if (cache_[i].dt == dt) {
+        last_use_[i] = ++clock_;
+        return cache_[i];
+      }
+      if (last_use_[i] < last_use_[oldest])
+        oldest = i;
+    }
+    if (cache_.size() < cache_size_) {
+      cache_.emplace_back();
+      last_use_.push_back(0);
+      oldest = cache_.size() - 1;
+    }
+    Discretization &d = cache_[oldest];
+    d.dt = dt;
+    vanLoan(dt, d.transfer, d.covariance);
+    last_use_[oldest] = ++clock_;
+    return d;
+  }
+
+  //! The drift matrix \f$\mathbf{A}\f$
+  arma::mat drift;
+  //! The diffusion matrix \f$\mathbf{Q}_c\f$
+  arma::mat diffusion;
+
+ private:
+  std::size_t cache_size_;
+  // a deque, its entries never move, also in a copied map
+  mutable std::deque<Discretization> cache_;
+  // time of the last use of every entry, the oldest is replaced
+  mutable std::vector<std::size_t> last_use_;
+  mutable std::size_t clock_ = 0;
+
+  // exp([-A Qc; 0 A^T] dt) = [. F^-1 Q; 0 F^T]
+  void vanLoan(double dt, arma::mat &trans, arma::mat &cov) const {
+    const arma::uword d = drift.n_rows;
+    arma::mat m = arma::zeros<arma::mat>(2 * d, 2 * d);
+    m.submat(0, 0, d - 1, d - 1) = -drift * dt;
+    m.submat(0, d, d - 1, 2 * d - 1) = diffusion * dt;
+    m.submat(d, d, 2 * d - 1, 2 * d - 1) = drift.t() * dt;
+    const arma::mat e = arma::expmat(m);
+    trans = e.submat(d, d, 2 * d - 1, 2 * d - 1).t();
+    cov = trans * e.submat(0, d, d - 1, 2 * d - 1);
+    // remove the round-off asymmetry, Gaussian factorizes it
+    cov = (cov + cov.t()) / 2;
+  }
+};
+
+} // namespace map
+} // namespace ssmkit
+
+#endif // SSMPACK_MODEL_CONTINUOUS_LINEAR_GAUSSIAN_HPP
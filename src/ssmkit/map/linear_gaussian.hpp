@@ -3,18 +3,40 @@
 
 #include <armadillo>
 
+#include <tuple>
+
 namespace ssmkit {
 namespace map {
 
 struct LinearGaussian {
-  using TParameter = std::tuple<arma::vec, arma::mat>;
+  /** The mean is a new vector, the covariance refers to #covariance of the
+   * map, so it is not copied per call. The reference is valid as long as the
+   * map is.
+   */
+  using TParameter = std::tuple<arma::vec, const arma::mat &>;
+  using TBatchParameter = std::tuple<arma::mat, const arma::mat &>;
   using TConditionVAR = arma::vec;
   
   LinearGaussian(arma::mat trans, arma::mat cov) : transfer{trans},
   covariance{cov} {}
 // should not be overloaded, should not be template
   TParameter operator()(const TConditionVAR &x) const {
-    return std::make_tuple(transfer * x, covariance);
+    return TParameter(transfer * x, covariance);
+  }
+
+  /** Writes the mean of condition \p x into \p out, which is not reallocated
+   * if it has the right size. It is not an overload of the call operator
+   * since the process traits take the address of that.
+   */
+  void mean(arma::vec &out, const TConditionVAR &x) const {
+    out = transfer * x;
+  }
+
+  /** Parameters of a block of conditions, one condition per column of \p x.
+   * The means of all columns are computed with one matrix-matrix product.
+   */
+  TBatchParameter batch(const arma::mat &x) const {
+    return TBatchParameter(transfer * x, covariance);
   }
 
   arma::mat transfer;
@@ -0,0 +1,49 @@
+#ifndef SSMPACK_MODEL_SPARSE_LINEAR_GAUSSIAN_HPP
+#define SSMPACK_MODEL_SPARSE_LINEAR_GAUSSIAN_HPP
+
+#include <armadillo>
+
+#include <tuple>
+
+namespace ssmkit {
+namespace map {
+
+/** Linear Gaussian map with a sparse transfer matrix.
+ *
+ * Same as map::LinearGaussian but \a transfer is stored as arma::sp_mat, so
+ * mapping a condition costs \f$O(nnz)\f$ instead of \f$O(D^2)\f$. The
+ * covariance is kept dense since distribution::Gaussian factorizes it.
+ */
+struct SparseLinearGaussian {
+  //! The covariance refers to #covariance, see map::LinearGaussian::TParameter
+  using TParameter = std::tuple<arma::vec, const arma::mat &>;
+  using TBatchParameter = std::tuple<arma::mat, const arma::mat &>;
+  using TConditionVAR = arma::vec;
+
+  SparseLinearGaussian(arma::sp_mat trans, arma::mat cov)
+      : transfer{trans}, covariance{cov} {}
+  // should not be overloaded, should not be template
+  TParameter operator()(const TConditionVAR &x) const {
+    return TParameter(arma::vec(transfer * x), covariance);
+  }
+
+  //! Writes the mean into \p out, see map::LinearGaussian::mean
+  void mean(arma::vec &out, const TConditionVAR &x) const {
+    out = transfer * x;
+  }
+
+  /** Parameters of a block of conditions, one condition per column of \p x.
+   * The means of all columns are computed with one sparse-dense product.
+   */
+  TBatchParameter batch(const arma::mat &x) const {
+    return TBatchParameter(arma::mat(transfer * x), covariance);
+  }
+
+  arma::sp_mat transfer;
+  arma::mat covariance;
+};
+
+} // namespace map
+} // namespace ssmkit
+
+#endif // SSMPACK_MODEL_SPARSE_LINEAR_GAUSSIAN_HPP
@@ -3,18 +3,38 @@
 
 #include <armadillo>
 
+#include <tuple>
+#include <utility>
+
 namespace ssmkit {
 namespace map {
 
 struct SwitchingAdditiveLinearGaussian {
-  using TParameter = std::tuple<arma::vec, arma::mat>;
+  //! The covariance refers to #covariance, see map::LinearGaussian::TParameter
+  using TParameter = std::tuple<arma::vec, const arma::mat &>;
+  using TBatchParameter = std::tuple<arma::mat, const arma::mat &>;
   using TConditionVAR = arma::vec;
 
   SwitchingAdditiveLinearGaussian(arma::mat trans, arma::mat cov, arma::mat b)
       : biases{b}, transfer{trans}, covariance{cov} {}
   // should not be overloaded, should not be template
   TParameter operator()(const TConditionVAR &x, const int &k) const {
-    return std::make_tuple(transfer * x + biases.col(k), covariance);
+    return TParameter(transfer * x + biases.col(k), covariance);
+  }
+
+  //! Writes the mean into \p out, see map::LinearGaussian::mean
+  void mean(arma::vec &out, const TConditionVAR &x, const int &k) const {
+    out = transfer * x;
+    out += biases.col(k);
+  }
+
+  /** Parameters of a block of conditions, one condition per column of \p x.
+   * All the columns share the same mode \p k.
+   */
+  TBatchParameter batch(const arma::mat &x, const int &k) const {
+    arma::mat means = transfer * x;
+    means.each_col() += biases.col(k);
+    return TBatchParameter(std::move(means), covariance);
   }
 
   arma::mat biases;
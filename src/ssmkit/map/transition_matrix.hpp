@@ -1,8 +1,13 @@
 #ifndef SSMPACK_MODEL_TRANSITION_MATRIX_HPP
 #define SSMPACK_MODEL_TRANSITION_MATRIX_HPP
 
+#include "ssmkit/distribution/categorical.hpp"
+#include "ssmkit/distribution/conditional.hpp"
+
 #include <armadillo>
 
+#include <vector>
+
 namespace ssmkit {
 namespace map {
 
@@ -21,6 +26,63 @@ struct TransitionMatrix {
 
 
 } // namespace map
+
+namespace distribution {
+
+/** Conditional categorical distribution defined by a transition matrix
+ *
+ * Specialization of Conditional for switching processes
+ * \f$p(x|y) = \mathcal{Cat}(\mathbf{T}_{:,y})\f$. A sampler is built for every
+ * source state \f$y\f$ on construction, thus random() does not
+ * re-parameterize the distribution and does not allocate.
+ */
+template <>
+class Conditional<Categorical, map::TransitionMatrix> {
+ public:
+  /** Constructors returns a conditional distribution object.
+   * @param pdf A Categorical distribution object.
+   * @param map The transition matrix map, every column should sum to 1.0.
+   */
+  Conditional(Categorical pdf, map::TransitionMatrix map)
+      : pdf_(std::move(pdf)), map_(std::move(map)) {
+    samplers_.reserve(map_.transfer.n_cols);
+    for (arma::uword i = 0; i < map_.transfer.n_cols; ++i)
+      samplers_.emplace_back(map_(i));
+  }
+  /** Sample from distribution
+   *
+   * @param x Source state \f$y\f$.
+   * @return random variable \f$x\f$.
+   */
+  unsigned int random(const map::TransitionMatrix::TConditionVAR &x) {
+    return samplers_[x].random();
+  }
+
+  /** Calculate the likelihood of a random variable
+   *
+   * @param rv random variable \f$x\f$.
+   * @param x Source state \f$y\f$.
+   * @return likelihood \f$p(x|y)\f$.
+   */
+  double likelihood(const unsigned int &rv,
+                    const map::TransitionMatrix::TConditionVAR &x) const {
+    return map_.transfer(rv, x);
+  }
+
+  //! Returns a reference to \f$\mathcal{F}(\theta)\f$.
+  const Categorical & getPDF() const {return pdf_;}
+  //! Returns a reference to \f$g(.)\f$.
+  const map::TransitionMatrix & getParamMap() const {return map_;}
+ private:
+  //! \f$\mathcal{F}(\theta)\f$.
+  Categorical pdf_;
+  //! \f$g(.)\f$.
+  map::TransitionMatrix map_;
+  //! Sampler of every source state \f$\mathcal{Cat}(\mathbf{T}_{:,y})\f$.
+  std::vector<Categorical> samplers_;
+};
+
+} // namespace distribution
 } // namespace ssmkit
 
 #endif // SSMPACK_MODEL_TRANSITION_MATRIX_HPP
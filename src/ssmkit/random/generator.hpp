@@ -7,12 +7,22 @@
 #ifndef SSMPACK_RANDOM_GENERATOR_HPP
 #define SSMPACK_RANDOM_GENERATOR_HPP
 
+#include "ssmkit/random/philox.hpp"
+
+#include <cstdint>
 #include <random>
 
 namespace ssmkit {
 namespace random {
 
+/* Define SSMKIT_RANDOM_PHILOX (cmake -DPHILOX=ON) to use the counter-based
+ * engine, which gives independent and reproducible streams per thread.
+ */
+#ifdef SSMKIT_RANDOM_PHILOX
+typedef Philox CoreGenerator;
+#else
 typedef std::mt19937 CoreGenerator;
+#endif
 
 /** A singleton wrapper of an instance of random generator.
  * This is used in the rendom() methods of distribution classes.
@@ -45,6 +55,17 @@ class Generator {
   //! Sets the seed for the core generator
   template<class TSeed>
   void setSeed(TSeed seed) {gen_.seed(seed);}
+  /** Sets the seed and the stream id for the core generator
+   *
+   * With Philox, every (seed, stream) pair selects a non-overlapping
+   * sub-sequence, e.g. seeding every thread with its own stream id makes the
+   * outcome independent of the number of threads and the scheduling. With
+   * std::mt19937 the pair is mixed by std::seed_seq, which is reproducible
+   * but does not guarantee non-overlapping sequences.
+   */
+  void setSeed(std::uint64_t seed, std::uint64_t stream) {
+    seedStream(gen_, seed, stream);
+  }
   //! Sets a random seed for core generator
   void setRandomSeed()
   {
@@ -52,6 +73,21 @@ class Generator {
     gen_.seed(rd());
   }
 
+ private:
+  static void seedStream(Philox &gen, std::uint64_t seed,
+                         std::uint64_t stream) {
+    gen.seed(seed, stream);
+  }
+  template <class TGenerator>
+  static void seedStream(TGenerator &gen, std::uint64_t seed,
+                         std::uint64_t stream) {
+    std::seed_seq seq{static_cast<std::uint32_t>(seed),
+                      static_cast<std::uint32_t>(seed >> 32),
+                      static_cast<std::uint32_t>(stream),
+                      static_cast<std::uint32_t>(stream >> 32)};
+    gen.seed(seq);
+  }
+
 };
 
 //! Convenient function to set random seed for singleton generator object
@@ -67,6 +103,12 @@ void setSeed(TSeed seed)
   Generator::get().setSeed(seed);
 }
 
+//! Convenient function to set seed and stream id for singleton generator object
+inline void setSeed(std::uint64_t seed, std::uint64_t stream)
+{
+  Generator::get().setSeed(seed, stream);
+}
+
 } // namespace random
 } // namespace ssmkit
 
@@ -0,0 +1,154 @@
+/**
+ * @file philox.hpp
+ * @author Vahid Bastani
+ *
+ * Counter-based Philox4x32-10 random number engine.
+ */
+#ifndef SSMPACK_RANDOM_PHILOX_HPP
+#define SSMPACK_RANDOM_PHILOX_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace ssmkit {
+namespace random {
+
+/** Philox4x32-10 counter-based random number engine.
+ *
+ * The n-th output is a bijection of the key (the seed) and a 128-bit counter,
+ * hence the state is only a few words and the sequence can be split into
+ * \f$2^{64}\f$ independent streams, each of length \f$2^{66}\f$, by a (seed,
+ * stream id) pair. Assigning stream ids to threads, tasks or particles makes a
+ * parallel simulation reproducible regardless of scheduling. Satisfies the
+ * requirements of UniformRandomBitGenerator.
+ *
+ * J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw, "Parallel random
+ * numbers: As easy as 1, 2, 3," SC '11, 2011.
+ */
+class Philox {
+ public:
+  using result_type = std::uint32_t;
+  //! Type of the counter and the output block
+  using TBlock = std::array<std::uint32_t, 4>;
+  //! Type of the key
+  using TKey = std::array<std::uint32_t, 2>;
+
+ private:
+  //! Key derived from the seed
+  TKey key_;
+  //! Counter, first two words are block index and last two the stream id
+  TBlock counter_;
+  //! Outputs of the current block
+  TBlock output_;
+  //! Index of the next unused element of output_
+  unsigned int index_;
+
+  static void mulhilo(std::uint32_t a, std::uint32_t b, std::uint32_t &hi,
+                      std::uint32_t &lo) {
+    const std::uint64_t p = static_cast<std::uint64_t>(a) * b;
+    hi = static_cast<std::uint32_t>(p >> 32);
+    lo = static_cast<std::uint32_t>(p);
+  }
+  //! Increments the 64-bit block index of the counter
+  void incrementCounter() {
+    if (++counter_[0] == 0)
+      ++counter_[1];
+  }
+
+ public:
+  //! Default seed of the engine
+  static constexpr std::uint64_t default_seed = 5489u;
+
+  //! Constructs the engine with the given seed on stream zero.
+  explicit Philox(std::uint64_t seed = default_seed) { this->seed(seed); }
+  //! Constructs the engine with the given seed on the given stream.
+  Philox(std::uint64_t seed, std::uint64_t stream) { this->seed(seed, stream); }
+
+  /** Counter-based bijection
+   *
+   * Returns the 10-round Philox4x32 output of \p counter under \p key.
+   */
+  static TBlock generate(TBlock counter, TKey key) {
+    for (int r = 0; r < 10; ++r) {
+      if (r > 0) {
+        key[0] += 0x9E3779B9;
+        key[1] += 0xBB67AE85;
+      }
+      std::uint32_t hi0, lo0, hi1, lo1;
+      mulhilo(0xD2511F53, counter[0], hi0, lo0);
+      mulhilo(0xCD9E8D57, counter[2], hi1, lo1);
+      counter = {{hi1 ^ counter[1] ^ key[0], lo1, hi0 ^ counter[3] ^ key[1],
+                  lo0}};
+    }
+    return counter;
+  }
+
+  //! Resets the engine to the beginning of stream zero of \p seed.
+  void seed(std::uint64_t seed = default_seed) { this->seed(seed, 0); }
+  //! Resets the engine to the beginning of \p stream of \p seed.
+  void seed(std::uint64_t seed, std::uint64_t stream) {
+    key_ = {{static_cast<std::uint32_t>(seed),
+             static_cast<std::uint32_t>(seed >> 32)}};
+    counter_ = {{0, 0, static_cast<std::uint32_t>(stream),
+                 static_cast<std::uint32_t>(stream >> 32)}};
+    index_ = 4;
+  }
+  //! Seeds the engine from a seed sequence, e.g. std::seed_seq.
+  template <class TSeedSeq, class = decltype(std::declval<TSeedSeq &>().generate(
+                                std::declval<std::uint32_t *>(),
+                                std::declval<std::uint32_t *>()))>
+  void seed(TSeedSeq &seq) {
+    std::array<std::uint32_t, 4> s;
+    seq.generate(s.begin(), s.end());
+    seed(s[0] | static_cast<std::uint64_t>(s[1]) << 32,
+         s[2] | static_cast<std::uint64_t>(s[3]) << 32);
+  }
+
+  //! Returns the next 32-bit output.
+  result_type operator()() {
+    if (index_ == 4) {
+      output_ = generate(counter_, key_);
+      incrementCounter();
+      index_ = 0;
+    }
+    return output_[index_++];
+  }
+
+  //! Advances the engine by \p z outputs in constant time.
+  void discard(unsigned long long z) {
+    const unsigned long long left = 4 - index_;
+    if (z < left) {
+      index_ += static_cast<unsigned int>(z);
+      return;
+    }
+    z -= left;
+    // skip whole blocks by moving the counter
+    const std::uint64_t blocks =
+        (static_cast<std::uint64_t>(counter_[1]) << 32 | counter_[0]) + z / 4;
+    counter_[0] = static_cast<std::uint32_t>(blocks);
+    counter_[1] = static_cast<std::uint32_t>(blocks >> 32);
+    index_ = 4;
+    if (z % 4 != 0) {
+      (*this)();
+      index_ = static_cast<unsigned int>(z % 4);
+    }
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  friend bool operator==(const Philox &a, const Philox &b) {
+    return a.key_ == b.key_ && a.counter_ == b.counter_ &&
+           a.index_ == b.index_;
+  }
+  friend bool operator!=(const Philox &a, const Philox &b) { return !(a == b); }
+};
+
+} // namespace random
+} // namespace ssmkit
+
+#endif // SSMPACK_RANDOM_PHILOX_HPP
@@ -0,0 +1,221 @@
+/**
+ * @file sobol.hpp
+ * @author Vahid Bastani
+ *
+ * Scrambled Sobol low-discrepancy sequence.
+ */
+#ifndef SSMPACK_RANDOM_SOBOL_HPP
+#define SSMPACK_RANDOM_SOBOL_HPP
+
+#include "ssmkit/random/generator.hpp"
+#include "ssmkit/random/normal.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace ssmkit {
+namespace random {
+
+/** Randomized Sobol sequence as a sample source for quasi-Monte Carlo.
+ *
+ * Generates points of \f$[0, 1)^D\f$ (or \f$\mathbb{R}^D\f$ through the normal
+ * quantile) in Gray-code order. The first 21 dimensions use the direction
+ * numbers of Joe and Kuo, further dimensions use the next primitive
+ * polynomials with pseudo-random initial direction numbers. With scrambling
+ * enabled, a random linear matrix scramble and a random digital shift are
+ * drawn from Generator, so every point is uniformly distributed while the
+ * point set keeps its low discrepancy (randomized QMC).
+ *
+ * S. Joe and F. Y. Kuo, "Constructing Sobol sequences with better
+ * two-dimensional projections," SIAM J. Sci. Comput., vol. 30, pp.
+ * 2635-2654, 2008.
+ *
+ * J. Matousek, "On the L2-discrepancy for anchored boxes," J. Complexity,
+ * vol. 14, pp. 527-556, 1998.
+ *
+ * @note The first \f$2^m\f$ points form a balanced net, use power of two
+ * number of points (e.g. particles) for the best uniformity.
+ */
+class Sobol {
+ private:
+  //! Number of bits of every coordinate
+  static constexpr unsigned int bits = 32;
+  //! Dimension \f$D\f$
+  unsigned int dim_;
+  //! Direction numbers, bits per dimension
+  std::vector<std::uint32_t> v_;
+  //! Current point before digital shift
+  std::vector<std::uint32_t> x_;
+  //! Digital shift of every dimension
+  std::vector<std::uint32_t> shift_;
+  //! Index of the current point
+  std::uint32_t index_;
+
+  //! Returns true if polynomial of degree \p s given by bits \p poly is primitive
+  static bool isPrimitive(std::uint32_t poly, unsigned int s) {
+    const std::uint32_t period = (std::uint32_t(1) << s) - 1;
+    std::uint32_t r = 1;
+    for (std::uint32_t n = 1; n <= period; ++n) {
+      r <<= 1;
+      if (r & (std::uint32_t(1) << s))
+        r ^= poly;
+      if (r == 1)
+        return n == period;
+    }
+    return false;
+  }
+
+  //! Computes unscrambled direction numbers of all dimensions
+  void calcDirections() {
+    // initial direction numbers m_i of dimensions 2 to 21 (Joe-Kuo)
+    static const std::uint32_t joe_kuo[][7] = {
+        {1},
+        {1, 3},
+        {1, 3, 1},
+        {1, 1, 1},
+        {1, 1, 3, 3},
+        {1, 3, 5, 13},
+        {1, 1, 5, 5, 17},
+        {1, 1, 5, 5, 5},
+        {1, 1, 7, 11, 19},
+        {1, 1, 5, 1, 1},
+        {1, 1, 1, 3, 11},
+        {1, 3, 5, 5, 31},
+        {1, 3, 3, 9, 7, 49},
+        {1, 1, 1, 15, 21, 21},
+        {1, 3, 1, 13, 27, 49},
+        {1, 1, 1, 15, 7, 5},
+        {1, 3, 1, 15, 13, 25},
+        {1, 1, 5, 5, 19, 61},
+        {1, 3, 7, 11, 23, 15, 103},
+        {1, 3, 7, 13, 13, 15, 69}};
+    const unsigned int table_size = sizeof(joe_kuo) / sizeof(joe_kuo[0]);
+
+    v_.assign(dim_ * bits, 0);
+    // first dimension is van der Corput sequence
+    for (unsigned int i = 0; i < bits; ++i)
+      v_[i] = std::uint32_t(1) << (bits - 1 - i);
+
+    // fixed generator for initial direction numbers beyond the table
+    std::minstd_rand m_gen(1);
+    unsigned int s = 1;
+    std::uint32_t a = 0;
+    for (unsigned int j = 1; j < dim_; ++j) {
+      // next primitive polynomial in order of degree and coefficients
+      while (!isPrimitive((std::uint32_t(1) << s) | (a << 1) | 1, s)) {
+        if (++a == (std::uint32_t(1) << (s - 1))) {
+          ++s;
+          a = 0;
+        }
+      }
+      std::uint32_t *v = &v_[j * bits];
+      for (unsigned int i = 0; i < s && i < bits; ++i) {
+        std::uint32_t m = j - 1 < table_size
+                              ? joe_kuo[j - 1][i]
+                              : (m_gen() % (std::uint32_t(2) << i)) | 1;
+        v[i] = m << (bits - 1 - i);
+      }
+      for (unsigned int i = s; i < bits; ++i) {
+        v[i] = v[i - s] ^ (v[i - s] >> s);
+        for (unsigned int k = 1; k < s; ++k)
+          if ((a >> (s - 1 - k)) & 1)
+            v[i] ^= v[i - k];
+      }
+      // move to next candidate polynomial
+      if (++a == (std::uint32_t(1) << (s - 1))) {
+        ++s;
+        a = 0;
+      }
+    }
+  }
+
+  //! Applies a random lower triangular binary matrix to direction numbers
+  template <class TGenerator>
+  void scrambleDirections(TGenerator &gen) {
+    std::uniform_int_distribution<std::uint32_t> word;
+    for (unsigned int j = 0; j < dim_; ++j) {
+      // row k of the matrix: one on the diagonal, random more significant bits
+      std::uint32_t rows[bits];
+      for (unsigned int k = 0; k < bits; ++k) {
+        const unsigned int b = bits - 1 - k;
+        const std::uint32_t upper =
+            b == bits - 1 ? 0 : ~((std::uint32_t(1) << (b + 1)) - 1);
+        rows[k] = (std::uint32_t(1) << b) | (word(gen) & upper);
+      }
+      for (unsigned int i = 0; i < bits; ++i) {
+        std::uint32_t &v = v_[j * bits + i];
+        std::uint32_t scrambled = 0;
+        for (unsigned int k = 0; k < bits; ++k) {
+          std::uint32_t t = rows[k] & v, parity = 0;
+          for (; t; t &= t - 1)
+            parity ^= 1;
+          scrambled |= parity << (bits - 1 - k);
+        }
+        v = scrambled;
+      }
+      shift_[j] = word(gen);
+    }
+  }
+
+ public:
+  /** Constructor
+   *
+   * @param dim Dimension \f$D\f$ of the points.
+   * @param scramble Randomize the sequence using Generator.
+   */
+  explicit Sobol(unsigned int dim, bool scramble = true)
+      : dim_(dim), x_(dim, 0), shift_(dim, 0), index_(0) {
+    calcDirections();
+    if (scramble)
+      scrambleDirections(Generator::get().getGenerator());
+  }
+
+  //! Returns dimension \f$D\f$ of the points.
+  unsigned int dimension() const { return dim_; }
+
+  //! Restarts the sequence from its first point.
+  void reset() {
+    std::fill(x_.begin(), x_.end(), 0);
+    index_ = 0;
+  }
+
+  /** Fills a buffer with the next \p n points in \f$(0, 1)^D\f$.
+   * @param[out] out Buffer of \f$D n\f$ elements, points are stored
+   * contiguously, i.e. as columns of a column-major \f$D \times n\f$ matrix.
+   * @param n Number of points.
+   */
+  void uniform(double *out, std::size_t n) {
+    for (std::size_t p = 0; p < n; ++p) {
+      for (unsigned int j = 0; j < dim_; ++j)
+        *out++ = ((x_[j] ^ shift_[j]) + 0.5) * (1.0 / 4294967296.0);
+      // Gray-code update, flip direction of the lowest zero bit of index
+      unsigned int c = 0;
+      for (std::uint32_t i = index_; i & 1; i >>= 1)
+        ++c;
+      for (unsigned int j = 0; j < dim_; ++j)
+        x_[j] ^= v_[j * bits + c];
+      ++index_;
+    }
+  }
+
+  /** Fills a buffer with the next \p n points transformed to \f$\mathcal{N}(0, I)\f$.
+   *
+   * Every coordinate is mapped through normalQuantile().
+   *
+   * @param[out] out Buffer of \f$D n\f$ elements, see uniform().
+   * @param n Number of points.
+   */
+  void normal(double *out, std::size_t n) {
+    uniform(out, n);
+    for (double *last = out + dim_ * n; out != last; ++out)
+      *out = normalQuantile(*out);
+  }
+};
+
+} // namespace random
+} // namespace ssmkit
+
+#endif // SSMPACK_RANDOM_SOBOL_HPP
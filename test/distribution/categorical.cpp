@@ -40,6 +40,48 @@ BOOST_AUTO_TEST_CASE(mc_test_random_arbitary_pdf)
   BOOST_CHECK(arma::approx_equal(hist_n, probabilities, "absdiff", 0.005));
 }
 
+BOOST_AUTO_TEST_CASE(mc_test_random_alias_pdf)
+{
+  // testing distribution with many categories, sampled with alias table
+  constexpr unsigned int categories = 40;
+  arma::vec probabilities = arma::linspace<arma::vec>(0, 1, categories);
+  probabilities(7) = 0.0;
+  probabilities /= arma::accu(probabilities);
+  distribution::Categorical pdf(probabilities);
+
+  // making histogram of returned samples
+  arma::vec hist = arma::zeros<arma::vec>(categories);
+  random::setRandomSeed();
+  for(int ii=0; ii<mc_n; ++ii)
+    ++hist(pdf.random());
+  // check if normalized histogram is equal to the given probabilities
+  BOOST_CHECK(arma::approx_equal(hist / mc_n, probabilities, "absdiff", 0.005));
+  // categories with zero probability should never be drawn
+  BOOST_CHECK_EQUAL(hist(0), 0);
+  BOOST_CHECK_EQUAL(hist(7), 0);
+}
+
+BOOST_AUTO_TEST_CASE(mc_test_random_n)
+{
+  // bulk sampling in both linear search and alias mode
+  for (unsigned int categories : {5u, 40u}) {
+    arma::vec probabilities =
+        arma::ones<arma::vec>(categories) / categories;
+    distribution::Categorical pdf;
+    pdf.parameterize(probabilities);
+
+    random::setRandomSeed();
+    arma::uvec samples = pdf.random_n(mc_n);
+    BOOST_REQUIRE_EQUAL(samples.n_rows, mc_n);
+    BOOST_CHECK(samples.max() < categories);
+
+    arma::vec hist = arma::zeros<arma::vec>(categories);
+    samples.for_each([&hist](const arma::uword &s) { ++hist(s); });
+    BOOST_CHECK(arma::approx_equal(hist / mc_n, probabilities, "absdiff",
+                                   0.005));
+  }
+}
+
 BOOST_AUTO_TEST_CASE(likelihood_test)
 {
 }
@@ -18,3 +18,115 @@
 //}
 //
 //BOOST_AUTO_TEST_SUITE_END();
+
+#include <boost/test/unit_test.hpp>
+
+#include "ssmkit/map/linear_gaussian.hpp"
+#include "ssmkit/map/switching_additive_linear_gaussian.hpp"
+#include "ssmkit/map/transition_matrix.hpp"
+#include "ssmkit/distribution/categorical.hpp"
+#include "ssmkit/distribution/gaussian.hpp"
+#include "ssmkit/distribution/conditional.hpp"
+
+using namespace ssmkit;
+
+namespace {
+// same as map::LinearGaussian but without batch method
+struct NoBatchLinearGaussian {
+  using TParameter = std::tuple<arma::vec, arma::mat>;
+  NoBatchLinearGaussian(arma::mat trans, arma::mat cov)
+      : transfer{trans}, covariance{cov} {}
+  TParameter operator()(const arma::vec &x) const {
+    return std::make_tuple(transfer * x, covariance);
+  }
+  arma::mat transfer;
+  arma::mat covariance;
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(distribution_conditional);
+
+BOOST_AUTO_TEST_CASE(batch_likelihood) {
+  arma::mat transfer{{1, 0.1}, {0, 1}};
+  arma::mat covariance{{0.5, 0.1}, {0.1, 0.3}};
+  arma::mat conditions{{0, 1, 2, -3}, {1, 0, -1, 2}};
+  arma::mat rvs{{0.1, 1.2, 1.5, -2}, {0.8, -0.1, -1, 2.5}};
+
+  auto cpdf = distribution::makeConditional(
+      distribution::Gaussian(2), map::LinearGaussian(transfer, covariance));
+  auto cpdf_nb = distribution::makeConditional(
+      distribution::Gaussian(2), NoBatchLinearGaussian(transfer, covariance));
+
+  arma::vec expected(conditions.n_cols);
+  for (arma::uword i = 0; i < conditions.n_cols; ++i)
+    expected(i) = cpdf.likelihood(arma::vec(rvs.col(i)),
+                                  arma::vec(conditions.col(i)));
+
+  BOOST_CHECK(arma::approx_equal(cpdf.likelihood(rvs, conditions), expected,
+                                 "absdiff", 1e-9));
+  BOOST_CHECK(arma::approx_equal(cpdf_nb.likelihood(rvs, conditions),
+                                 expected, "absdiff", 1e-9));
+
+  // one random variable against every condition
+  arma::vec rv = rvs.col(0);
+  for (arma::uword i = 0; i < conditions.n_cols; ++i)
+    expected(i) = cpdf.likelihood(rv, arma::vec(conditions.col(i)));
+  arma::mat rv_block = rv;
+  BOOST_CHECK(arma::approx_equal(cpdf.likelihood(rv_block, conditions),
+                                 expected, "absdiff", 1e-9));
+}
+
+BOOST_AUTO_TEST_CASE(batch_random) {
+  arma::mat transfer{{1, 0.1}, {0, 1}};
+  arma::mat covariance = arma::eye<arma::mat>(2, 2) * 1e-8;
+  arma::mat biases{{0, 1}, {0, -1}};
+  arma::mat conditions{{0, 1, 2, -3}, {1, 0, -1, 2}};
+
+  auto cpdf = distribution::makeConditional(
+      distribution::Gaussian(2), map::LinearGaussian(transfer, covariance));
+  auto cpdf_nb = distribution::makeConditional(
+      distribution::Gaussian(2), NoBatchLinearGaussian(transfer, covariance));
+  auto cpdf_sw = distribution::makeConditional(
+      distribution::Gaussian(2),
+      map::SwitchingAdditiveLinearGaussian(transfer, covariance, biases));
+
+  random::setRandomSeed();
+  arma::mat samples = cpdf.random(conditions);
+  BOOST_REQUIRE_EQUAL(samples.n_rows, 2);
+  BOOST_REQUIRE_EQUAL(samples.n_cols, conditions.n_cols);
+  BOOST_CHECK(arma::approx_equal(samples, transfer * conditions, "absdiff",
+                                 1e-3));
+
+  samples = cpdf_nb.random(conditions);
+  BOOST_REQUIRE_EQUAL(samples.n_cols, conditions.n_cols);
+  BOOST_CHECK(arma::approx_equal(samples, transfer * conditions, "absdiff",
+                                 1e-3));
+
+  samples = cpdf_sw.random(conditions, 1);
+  arma::mat expected = transfer * conditions;
+  expected.each_col() += biases.col(1);
+  BOOST_CHECK(arma::approx_equal(samples, expected, "absdiff", 1e-3));
+}
+
+BOOST_AUTO_TEST_CASE(transition_matrix_random) {
+  // sampling from cached per-state samplers
+  constexpr int mc_n = 200000;
+  arma::mat transition_matrix{
+      {0.8, 0.1, 0.0}, {0.1, 0.8, 0.3}, {0.1, 0.1, 0.7}};
+  auto cpdf = distribution::makeConditional(
+      distribution::Categorical(), map::TransitionMatrix(transition_matrix));
+
+  random::setRandomSeed();
+  for (int source = 0; source < 3; ++source) {
+    arma::vec hist = arma::zeros<arma::vec>(3);
+    for (int ii = 0; ii < mc_n; ++ii)
+      ++hist(cpdf.random(source));
+    BOOST_CHECK(arma::approx_equal(hist / mc_n, transition_matrix.col(source),
+                                   "absdiff", 0.005));
+    for (unsigned int k = 0; k < 3; ++k)
+      BOOST_CHECK_EQUAL(cpdf.likelihood(k, source),
+                        transition_matrix(k, source));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -2,6 +2,8 @@
 #include <iostream>
 
 #include "ssmkit/distribution/gaussian.hpp"
+#include "ssmkit/map/linear_gaussian.hpp"
+#include "ssmkit/random/sobol.hpp"
 
 #define STR_EXPAND(tok) #tok
 #define STR(tok) STR_EXPAND(tok)
@@ -67,6 +69,69 @@ BOOST_AUTO_TEST_CASE(mc_test_random_arbitary_pdf) {
   BOOST_CHECK(arma::approx_equal(covariance, mc_covariance, "absdiff", 0.5));
 }
 
+BOOST_AUTO_TEST_CASE(mc_test_random_n_arbitary_pdf) {
+  // testing bulk sampling with given mean and covariance
+
+  // construction distribution
+  constexpr int dimension = 2;
+  arma::vec mean{89, 16};
+  arma::mat chol{{10, 1}, {0, 2}};
+  arma::mat covariance = chol.t() * chol;
+  distribution::Gaussian pdf(mean, covariance);
+
+  // set random seed
+  random::setRandomSeed();
+
+  // sampling large number of random variables in one call
+  arma::mat samples = pdf.random_n(mc_n);
+  BOOST_REQUIRE_EQUAL(samples.n_rows, dimension);
+  BOOST_REQUIRE_EQUAL(samples.n_cols, mc_n);
+  // Calculating sample mean
+  arma::vec mc_mean = arma::sum(samples, 1) / mc_n;
+  // Calculating sample covariance
+  arma::mat mc_covariance = arma::cov(samples.t());
+
+  // check if sample mean is close to the given mean
+  BOOST_CHECK(arma::approx_equal(mean, mc_mean, "absdiff", 0.1));
+  // check if sample covariance is close to given covariance
+  BOOST_CHECK(arma::approx_equal(covariance, mc_covariance, "absdiff", 0.5));
+
+  // filling a preallocated block keeps its number of columns
+  arma::mat block(dimension, 10);
+  pdf.random(block);
+  BOOST_CHECK_EQUAL(block.n_rows, dimension);
+  BOOST_CHECK_EQUAL(block.n_cols, 10);
+}
+
+BOOST_AUTO_TEST_CASE(qmc_test_random_sobol_source) {
+  // randomized quasi-Monte Carlo sampling from a Sobol source
+  constexpr int dimension = 2;
+  constexpr int n = 1 << 14;
+  arma::vec mean{89, 16};
+  arma::mat chol{{10, 1}, {0, 2}};
+  arma::mat covariance = chol.t() * chol;
+  distribution::Gaussian pdf(mean, covariance);
+
+  random::setRandomSeed();
+  random::Sobol sobol(dimension);
+  arma::mat samples(dimension, n);
+  pdf.random(samples, sobol);
+
+  arma::vec qmc_mean = arma::sum(samples, 1) / n;
+  arma::mat qmc_covariance = arma::cov(samples.t());
+  // QMC error is much lower than MC with the same number of samples
+  BOOST_CHECK(arma::approx_equal(mean, qmc_mean, "absdiff", 0.01));
+  BOOST_CHECK(arma::approx_equal(covariance, qmc_covariance, "absdiff", 0.5));
+}
+
+BOOST_AUTO_TEST_CASE(random_source_dimension_test) {
+  // a source of another dimension is rejected
+  distribution::Gaussian pdf(2);
+  random::Sobol sobol(3);
+  arma::mat samples(2, 8);
+  BOOST_CHECK_THROW(pdf.random(samples, sobol), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_CASE(likelihood_test) {
   // check the likelihood function using precomputed data
   arma::mat rvs;
@@ -116,4 +181,128 @@ BOOST_AUTO_TEST_CASE(likelihood_test) {
   BOOST_CHECK(arma::approx_equal(lnc, lnc_test, "absdiff", 0.001));
 }
 
+BOOST_AUTO_TEST_CASE(log_likelihood_test) {
+  // check the log-likelihood function using precomputed data
+  arma::mat rvs;
+  arma::mat lnc;
+
+  BOOST_REQUIRE(rvs.load(STR(SOURCE_DIR) "/test/data/gaussian/rvs.csv"));
+  BOOST_REQUIRE(lnc.load(STR(SOURCE_DIR) "/test/data/gaussian/lnc.csv"));
+
+  arma::mat chol{{1, 1, 1}, {0, 1, 1}, {0, 0, 1}};
+  arma::mat covariance = chol.t() * chol;
+  distribution::Gaussian pdf(arma::zeros<arma::vec>(3), covariance);
+  arma::mat lnc_test(size(lnc));
+  auto it_lnc_test = lnc_test.begin();
+  rvs.each_col([&pdf, &it_lnc_test](arma::vec &col) {
+    *it_lnc_test++ = pdf.logLikelihood(col);
+  });
+  BOOST_CHECK(arma::approx_equal(arma::log(lnc), lnc_test, "absdiff", 0.001));
+}
+
+BOOST_AUTO_TEST_CASE(log_likelihood_high_dimension_test) {
+  // the determinant of covariance underflows, log-likelihood should not
+  constexpr int dimension = 40;
+  distribution::Gaussian pdf(arma::zeros<arma::vec>(dimension),
+                             arma::eye<arma::mat>(dimension, dimension) * 1e-10);
+
+  const double expected = -0.5 * dimension * std::log(2 * arma::datum::pi) -
+                          0.5 * dimension * std::log(1e-10);
+  const double ll = pdf.logLikelihood(arma::zeros<arma::vec>(dimension));
+  BOOST_CHECK(std::isfinite(ll));
+  BOOST_CHECK_CLOSE(ll, expected, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(parameterize_mean_only_test) {
+  // re-parameterizing with the same covariance should only move the mean
+  arma::mat chol{{1, 1, 1}, {0, 1, 1}, {0, 0, 1}};
+  arma::mat covariance = chol.t() * chol;
+  arma::vec mean{1, 2, 3};
+  arma::vec rv{0.5, -1, 2};
+
+  distribution::Gaussian pdf(arma::zeros<arma::vec>(3), covariance);
+  pdf.parameterize(mean, covariance);
+  distribution::Gaussian ref(mean, covariance);
+
+  BOOST_CHECK(arma::approx_equal(pdf.getMean(), mean, "absdiff", 1e-12));
+  BOOST_CHECK_CLOSE(pdf.logLikelihood(rv), ref.logLikelihood(rv), 1e-9);
+
+  // a changed covariance should still be factorized again
+  arma::mat covariance2 = covariance * 2.0;
+  pdf.parameterize(mean, covariance2);
+  distribution::Gaussian ref2(mean, covariance2);
+  BOOST_CHECK(arma::approx_equal(pdf.getCovariance(), covariance2, "absdiff",
+                                 1e-12));
+  BOOST_CHECK_CLOSE(pdf.logLikelihood(rv), ref2.logLikelihood(rv), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(parameterize_map_test) {
+  // a map returns a new mean and a reference to its own covariance, the mean
+  // can also be written into a given vector
+  arma::mat transfer{{1, 2}, {0, 1}};
+  arma::mat covariance{{2, 0.5}, {0.5, 1}};
+  map::LinearGaussian model(transfer, covariance);
+  arma::vec x{1, -1};
+  arma::vec rv{0.5, 1};
+
+  auto parameters = model(x);
+  auto other = model(arma::vec{2, 3});
+  BOOST_CHECK(arma::approx_equal(std::get<0>(parameters), transfer * x,
+                                 "absdiff", 1e-12));
+  BOOST_CHECK_EQUAL(&std::get<1>(parameters), &model.covariance);
+  BOOST_CHECK_EQUAL(&std::get<1>(other), &model.covariance);
+  arma::vec mean(2);
+  const double *memory = mean.memptr();
+  model.mean(mean, x);
+  BOOST_CHECK_EQUAL(mean.memptr(), memory);
+  BOOST_CHECK(arma::approx_equal(mean, std::get<0>(parameters), "absdiff",
+                                 1e-12));
+
+  distribution::Gaussian pdf(2);
+  pdf.parameterize(parameters);
+  distribution::Gaussian ref(transfer * x, covariance);
+  BOOST_CHECK(arma::approx_equal(pdf.getMean(), ref.getMean(), "absdiff",
+                                 1e-12));
+  BOOST_CHECK_CLOSE(pdf.logLikelihood(rv), ref.logLikelihood(rv), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(batch_likelihood_test) {
+  // batch evaluation should match column by column evaluation
+  arma::mat rvs;
+  arma::mat lnc;
+
+  BOOST_REQUIRE(rvs.load(STR(SOURCE_DIR) "/test/data/gaussian/rvs.csv"));
+  BOOST_REQUIRE(lnc.load(STR(SOURCE_DIR) "/test/data/gaussian/lnc.csv"));
+
+  arma::mat chol{{1, 1, 1}, {0, 1, 1}, {0, 0, 1}};
+  arma::mat covariance = chol.t() * chol;
+  distribution::Gaussian pdf(arma::zeros<arma::vec>(3), covariance);
+
+  arma::vec lnc_test = pdf.likelihoodBatch(rvs);
+  BOOST_REQUIRE_EQUAL(lnc_test.n_rows, rvs.n_cols);
+  BOOST_CHECK(arma::approx_equal(arma::vectorise(lnc), lnc_test, "absdiff",
+                                 0.001));
+
+  pdf.parameterize({1, 2, 3}, covariance);
+  arma::vec ll_test = pdf.logLikelihoodBatch(rvs);
+  arma::vec ll(rvs.n_cols);
+  auto it_ll = ll.begin();
+  rvs.each_col([&pdf, &it_ll](arma::vec &col) {
+    *it_ll++ = pdf.logLikelihood(col);
+  });
+  BOOST_CHECK(arma::approx_equal(ll, ll_test, "absdiff", 1e-9));
+}
+
+BOOST_AUTO_TEST_CASE(expression_argument_test) {
+  // subviews and expressions select the single point overloads
+  arma::mat rvs{{1, 2}, {0, 1}, {-1, 3}};
+  const arma::vec shift{0.5, 0.5, 0.5};
+  distribution::Gaussian pdf(3);
+
+  BOOST_CHECK_CLOSE(pdf.likelihood(rvs.col(1)),
+                    pdf.likelihood(arma::vec(rvs.col(1))), 1e-12);
+  BOOST_CHECK_CLOSE(pdf.logLikelihood(rvs.col(0) - shift),
+                    pdf.logLikelihood(arma::vec(rvs.col(0) - shift)), 1e-12);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
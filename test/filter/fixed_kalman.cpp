@@ -0,0 +1,94 @@
+#include <boost/test/unit_test.hpp>
+
+#include "ssmkit/filter/kalman.hpp"
+#include "ssmkit/filter/fixed_kalman.hpp"
+#include "ssmkit/map/linear_gaussian.hpp"
+#include "ssmkit/distribution/gaussian.hpp"
+#include "ssmkit/distribution/conditional.hpp"
+#include "ssmkit/process/markov.hpp"
+#include "ssmkit/process/memoryless.hpp"
+#include "ssmkit/process/hierarchical.hpp"
+
+#include <stdexcept>
+#include <tuple>
+
+using namespace ssmkit;
+
+BOOST_AUTO_TEST_SUITE(filter_fixed_kalman);
+
+BOOST_AUTO_TEST_CASE(compare_kalman_test) {
+  // the fixed dimension filter should give the same estimates as Kalman,
+  // here for a 3D constant velocity model with correlated position noise
+  double delta = 0.1;
+  arma::mat dynamic_matrix =
+      arma::kron(arma::mat{{1, delta}, {0, 1}}, arma::eye<arma::mat>(3, 3));
+  arma::mat dynamic_noise = arma::kron(arma::mat{{0.1, 0.05}, {0.05, 0.1}},
+                                       arma::eye<arma::mat>(3, 3));
+  arma::mat measurement_matrix =
+      arma::join_rows(arma::eye<arma::mat>(3, 3), arma::zeros<arma::mat>(3, 3));
+  arma::mat measurement_noise{
+      {0.1, 0.02, 0}, {0.02, 0.1, 0.01}, {0, 0.01, 0.2}};
+
+  auto dynamic_cpdf = distribution::makeConditional(
+      distribution::Gaussian(6),
+      map::LinearGaussian(dynamic_matrix, dynamic_noise));
+  auto measurement_cpdf = distribution::makeConditional(
+      distribution::Gaussian(3),
+      map::LinearGaussian(measurement_matrix, measurement_noise));
+  auto joint_process = process::makeHierarchical(
+      process::makeMarkov(dynamic_cpdf,
+                          distribution::Gaussian(arma::vec{1, 2, 3, 0, 0, 0},
+                                                 arma::eye<arma::mat>(6, 6))),
+      process::makeMemoryless(measurement_cpdf));
+
+  auto kalman = filter::makeKalman(joint_process);
+  auto fixed_kalman = filter::makeFixedKalman<6, 3>(joint_process);
+
+  kalman.initialize();
+  fixed_kalman.initialize();
+  for (int t = 0; t < 50; t++) {
+    arma::vec measurement{0.5 * t, -0.2 * t, 0.1 * t};
+    kalman.predict();
+    fixed_kalman.predict();
+    auto expected = kalman.correct(measurement);
+    auto state = fixed_kalman.correct(measurement);
+    BOOST_CHECK(arma::approx_equal(std::get<0>(expected),
+                                   arma::vec(std::get<0>(state)), "absdiff",
+                                   1e-10));
+    BOOST_CHECK(arma::approx_equal(std::get<1>(expected),
+                                   arma::mat(std::get<1>(state)), "absdiff",
+                                   1e-10));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(indefinite_innovation_test) {
+  // both filters should report an innovation covariance which is not
+  // positive definite
+  auto dynamic_cpdf = distribution::makeConditional(
+      distribution::Gaussian(2),
+      map::LinearGaussian(arma::eye<arma::mat>(2, 2),
+                          arma::eye<arma::mat>(2, 2) * 0.01));
+  auto measurement_cpdf = distribution::makeConditional(
+      distribution::Gaussian(2),
+      map::LinearGaussian(arma::eye<arma::mat>(2, 2),
+                          arma::mat{{1, 2}, {2, 1}}));
+  auto joint_process = process::makeHierarchical(
+      process::makeMarkov(dynamic_cpdf,
+                          distribution::Gaussian(arma::zeros<arma::vec>(2),
+                                                 arma::eye<arma::mat>(2, 2) *
+                                                     0.01)),
+      process::makeMemoryless(measurement_cpdf));
+
+  auto kalman = filter::makeKalman(joint_process);
+  auto fixed_kalman = filter::makeFixedKalman<2, 2>(joint_process);
+
+  kalman.initialize();
+  fixed_kalman.initialize();
+  kalman.predict();
+  fixed_kalman.predict();
+  BOOST_CHECK_THROW(kalman.correct(arma::vec{1, 1}), std::runtime_error);
+  BOOST_CHECK_THROW(fixed_kalman.correct(arma::vec{1, 1}),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,62 @@
+#include <boost/test/unit_test.hpp>
+
+#include "ssmkit/filter/kalman.hpp"
+#include "ssmkit/filter/information.hpp"
+#include "ssmkit/map/linear_gaussian.hpp"
+#include "ssmkit/distribution/gaussian.hpp"
+#include "ssmkit/distribution/conditional.hpp"
+#include "ssmkit/process/markov.hpp"
+#include "ssmkit/process/memoryless.hpp"
+#include "ssmkit/process/hierarchical.hpp"
+
+#include <tuple>
+
+using namespace ssmkit;
+
+BOOST_AUTO_TEST_SUITE(filter_information);
+
+BOOST_AUTO_TEST_CASE(compare_kalman_test) {
+  // many sensors observing a 2-d state, estimates should match Kalman
+  constexpr int measu_dim = 12;
+  arma::mat dynamic_matrix{{1, 0.1}, {0, 1}};
+  arma::mat dynamic_noise{{0.01, 0.005}, {0.005, 0.1}};
+  arma::mat measurement_matrix(measu_dim, 2);
+  for (int i = 0; i < measu_dim; i++) {
+    measurement_matrix(i, 0) = 1;
+    measurement_matrix(i, 1) = 0.1 * i;
+  }
+  arma::mat measurement_noise = arma::eye<arma::mat>(measu_dim, measu_dim);
+  measurement_noise.diag(1).fill(0.3);
+  measurement_noise.diag(-1).fill(0.3);
+
+  auto dynamic_cpdf = distribution::makeConditional(
+      distribution::Gaussian(2),
+      map::LinearGaussian(dynamic_matrix, dynamic_noise));
+  auto measurement_cpdf = distribution::makeConditional(
+      distribution::Gaussian(measu_dim),
+      map::LinearGaussian(measurement_matrix, measurement_noise));
+  auto joint_process = process::makeHierarchical(
+      process::makeMarkov(dynamic_cpdf,
+                          distribution::Gaussian(arma::zeros<arma::vec>(2),
+                                                 arma::eye<arma::mat>(2, 2))),
+      process::makeMemoryless(measurement_cpdf));
+
+  auto kalman = filter::makeKalman(joint_process);
+  auto information = filter::makeInformation(joint_process);
+
+  kalman.initialize();
+  information.initialize();
+  for (int t = 0; t < 20; t++) {
+    arma::vec measurement = arma::linspace<arma::vec>(0, 0.1 * t, measu_dim);
+    kalman.predict();
+    information.predict();
+    auto expected = kalman.correct(measurement);
+    auto state = information.correct(measurement);
+    BOOST_CHECK(arma::approx_equal(std::get<0>(expected), std::get<0>(state),
+                                   "absdiff", 1e-8));
+    BOOST_CHECK(arma::approx_equal(std::get<1>(expected), std::get<1>(state),
+                                   "absdiff", 1e-8));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
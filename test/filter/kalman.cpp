@@ -49,4 +49,594 @@
 //    BOOST_REQUIRE(arma::approx_equal(arma::mat({{0.6667,0},{0,2}}),kf.state().Covariance(), "absdiff", diff_tol));
 //}
 //
-//BOOST_AUTO_TEST_SUITE_END();
+//BOOST_AUTO_TEST_CASE(upper_product_panels_test) {
+  // dimensions over one panel of the upper triangle products should give
+  // the textbook covariances
+  const arma::uword n = 150, m = 70;
+  arma::arma_rng::set_seed(7);
+  arma::mat dynamic_matrix = arma::eye<arma::mat>(n, n) +
+                             0.01 * arma::randn<arma::mat>(n, n);
+  arma::mat noise_root = arma::randn<arma::mat>(n, n) / std::sqrt(n);
+  arma::mat dynamic_noise = noise_root * noise_root.t() +
+                          arma::eye<arma::mat>(n, n);
+  arma::mat measurement_matrix = arma::randn<arma::mat>(m, n);
+  arma::mat measurement_noise = arma::eye<arma::mat>(m, m) +
+                                0.1 * arma::ones<arma::mat>(m, m);
+  arma::mat covariance = arma::eye<arma::mat>(n, n);
+  auto kalman = makeKalman(
+      map::LinearGaussian(dynamic_matrix, dynamic_noise),
+      map::LinearGaussian(measurement_matrix, measurement_noise),
+      distribution::Gaussian(arma::zeros<arma::vec>(n), covariance));
+
+  kalman.initialize();
+  for (int t = 0; t < 3; t++) {
+    kalman.predict();
+    arma::mat predicted =
+        dynamic_matrix * covariance * dynamic_matrix.t() + dynamic_noise;
+    BOOST_CHECK(arma::approx_equal(kalman.getPredictedStateCovariance(),
+                                   predicted, "reldiff", 1e-9));
+    kalman.correctInPlace(arma::ones<arma::vec>(m));
+    arma::mat gain =
+        predicted * measurement_matrix.t() *
+        arma::inv(measurement_matrix * predicted * measurement_matrix.t() +
+                  measurement_noise);
+    covariance = predicted - gain * measurement_matrix * predicted;
+    BOOST_CHECK(arma::approx_equal(kalman.getStateCovariance(), covariance,
+                                   "absdiff", 1e-8));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+#include <boost/test/unit_test.hpp>
+
+#include "ssmkit/filter/kalman.hpp"
+#include "ssmkit/filter/square_root_kalman.hpp"
+#include "ssmkit/filter/gain_schedule.hpp"
+#include "ssmkit/map/linear_gaussian.hpp"
+#include "ssmkit/map/sparse_linear_gaussian.hpp"
+#include "ssmkit/map/block_linear_gaussian.hpp"
+#include "ssmkit/map/continuous_linear_gaussian.hpp"
+#include "ssmkit/distribution/gaussian.hpp"
+#include "ssmkit/distribution/conditional.hpp"
+#include "ssmkit/process/markov.hpp"
+#include "ssmkit/process/memoryless.hpp"
+#include "ssmkit/process/hierarchical.hpp"
+
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+
+using namespace ssmkit;
+
+namespace {
+template <class TMap>
+arma::uword noiseDimension(const TMap &model) {
+  return model.covariance.n_rows;
+}
+
+arma::uword noiseDimension(const map::BlockLinearGaussian &model) {
+  return model.blocks * model.block_covariance.n_rows;
+}
+
+arma::uword noiseDimension(const map::ContinuousLinearGaussian &model) {
+  return model.diffusion.n_rows;
+}
+
+template <class STA_MAP, class OBS_MAP>
+filter::Kalman<STA_MAP, OBS_MAP>
+makeKalman(const STA_MAP &dynamic_model, const OBS_MAP &measurement_model,
+           const distribution::Gaussian &initial) {
+  auto dynamic_cpdf = distribution::makeConditional(
+      distribution::Gaussian(noiseDimension(dynamic_model)), dynamic_model);
+  auto measurement_cpdf = distribution::makeConditional(
+      distribution::Gaussian(noiseDimension(measurement_model)),
+      measurement_model);
+  auto joint_process = process::makeHierarchical(
+      process::makeMarkov(dynamic_cpdf, initial),
+      process::makeMemoryless(measurement_cpdf));
+  return filter::makeKalman(joint_process);
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(filter_kalman);
+
+BOOST_AUTO_TEST_CASE(one_step_test) {
+  constexpr double diff_tol = 0.0001;
+  auto kalman = makeKalman(
+      map::LinearGaussian(arma::eye<arma::mat>(2, 2), arma::eye<arma::mat>(2, 2)),
+      map::LinearGaussian(arma::mat{{1, 0}}, arma::eye<arma::mat>(1, 1)),
+      distribution::Gaussian(arma::zeros<arma::vec>(2),
+                             arma::eye<arma::mat>(2, 2)));
+
+  auto state = kalman.initialize();
+  BOOST_CHECK(arma::approx_equal(arma::vec({0, 0}), std::get<0>(state),
+                                 "absdiff", diff_tol));
+
+  kalman.predict();
+  state = kalman.correct(arma::vec{1});
+  BOOST_CHECK(arma::approx_equal(arma::vec({0.6667, 0}), std::get<0>(state),
+                                 "absdiff", diff_tol));
+  BOOST_CHECK(arma::approx_equal(arma::mat({{0.6667, 0}, {0, 2}}),
+                                 std::get<1>(state), "absdiff", diff_tol));
+}
+
+BOOST_AUTO_TEST_CASE(indefinite_innovation_test) {
+  // an innovation covariance which is not positive definite is reported
+  auto kalman = makeKalman(
+      map::LinearGaussian(arma::eye<arma::mat>(2, 2),
+                          arma::eye<arma::mat>(2, 2) * 0.01),
+      map::LinearGaussian(arma::eye<arma::mat>(2, 2),
+                          arma::mat{{1, 2}, {2, 1}}),
+      distribution::Gaussian(arma::zeros<arma::vec>(2),
+                             arma::eye<arma::mat>(2, 2) * 0.01));
+
+  kalman.initialize();
+  kalman.predict();
+  BOOST_CHECK_THROW(kalman.correct(arma::vec{1, 1}), std::runtime_error);
+
+  // the same for the blocks of a decoupled block model
+  auto block = makeKalman(
+      map::BlockLinearGaussian(arma::eye<arma::mat>(1, 1),
+                               arma::eye<arma::mat>(1, 1) * 0.01, 2),
+      map::BlockLinearGaussian(arma::eye<arma::mat>(1, 1),
+                               arma::eye<arma::mat>(1, 1) * -1, 2),
+      distribution::Gaussian(arma::zeros<arma::vec>(2),
+                             arma::eye<arma::mat>(2, 2) * 0.01));
+
+  block.initialize();
+  block.predict();
+  BOOST_CHECK_THROW(block.correct(arma::vec{1, 1}), std::runtime_error);
+
+  // and for an exact sensor of a known component in the sequential update,
+  // the dynamics reset the second component to zero
+  auto sequential = makeKalman(
+      map::LinearGaussian(arma::diagmat(arma::vec{1, 0}),
+                          arma::diagmat(arma::vec{0.01, 0})),
+      map::LinearGaussian(arma::mat{{0, 1}}, arma::zeros<arma::mat>(1, 1)),
+      distribution::Gaussian(arma::zeros<arma::vec>(2),
+                             arma::eye<arma::mat>(2, 2)));
+
+  sequential.initialize();
+  sequential.predict();
+  BOOST_CHECK_THROW(sequential.correct(arma::vec{1}), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(sparse_transfer_test) {
+  // a sparse model should give the same estimates as the dense one
+  double delta = 0.1;
+  arma::mat dynamic_matrix{
+      {1, 0, delta, 0}, {0, 1, 0, delta}, {0, 0, 1, 0}, {0, 0, 0, 1}};
+  arma::mat dynamic_noise = arma::eye<arma::mat>(4, 4) * 0.1;
+  arma::mat measurement_matrix{{1, 0, 0, 0}, {0, 1, 0, 0}};
+  arma::mat measurement_noise = arma::eye<arma::mat>(2, 2) * 0.1;
+  distribution::Gaussian initial(arma::zeros<arma::vec>(4),
+                                 arma::eye<arma::mat>(4, 4));
+
+  auto dense = makeKalman(
+      map::LinearGaussian(dynamic_matrix, dynamic_noise),
+      map::LinearGaussian(measurement_matrix, measurement_noise), initial);
+  auto sparse = makeKalman(
+      map::SparseLinearGaussian(arma::sp_mat(dynamic_matrix), dynamic_noise),
+      map::SparseLinearGaussian(arma::sp_mat(measurement_matrix),
+                                measurement_noise),
+      initial);
+
+  dense.initialize();
+  sparse.initialize();
+  for (int t = 0; t < 10; t++) {
+    arma::vec measurement{0.5 * t, -0.2 * t};
+    dense.predict();
+    sparse.predict();
+    auto expected = dense.correct(measurement);
+    auto state = sparse.correct(measurement);
+    BOOST_CHECK(arma::approx_equal(std::get<0>(expected), std::get<0>(state),
+                                   "absdiff", 1e-10));
+    BOOST_CHECK(arma::approx_equal(std::get<1>(expected), std::get<1>(state),
+                                   "absdiff", 1e-10));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(block_model_test) {
+  // a block model should give the same estimates as the dense one, with
+  // independent (decoupled) and correlated initial blocks
+  constexpr unsigned int blocks = 3;
+  double delta = 0.1;
+  arma::mat dynamic_matrix{{1, delta}, {0, 1}};
+  arma::mat dynamic_noise{{0.01, 0.005}, {0.005, 0.1}};
+  arma::mat measurement_matrix{{1, 0}};
+  arma::mat measurement_noise = arma::eye<arma::mat>(1, 1) * 0.2;
+  arma::mat eye = arma::eye<arma::mat>(blocks, blocks);
+
+  arma::mat correlated = arma::eye<arma::mat>(2 * blocks, 2 * blocks);
+  correlated(0, 2) = correlated(2, 0) = 0.5;
+  for (const arma::mat &initial_cov :
+       {arma::mat(arma::eye<arma::mat>(2 * blocks, 2 * blocks)), correlated}) {
+    distribution::Gaussian initial(arma::zeros<arma::vec>(2 * blocks),
+                                   initial_cov);
+    auto dense = makeKalman(
+        map::LinearGaussian(arma::kron(eye, dynamic_matrix),
+                            arma::kron(eye, dynamic_noise)),
+        map::LinearGaussian(arma::kron(eye, measurement_matrix),
+                            arma::kron(eye, measurement_noise)),
+        initial);
+    auto block = makeKalman(
+        map::BlockLinearGaussian(dynamic_matrix, dynamic_noise, blocks),
+        map::BlockLinearGaussian(measurement_matrix, measurement_noise, blocks),
+        initial);
+
+    dense.initialize();
+    block.initialize();
+    for (int t = 0; t < 10; t++) {
+      arma::vec measurement{0.5 * t, -0.2 * t, 0.1 * t * t};
+      dense.predict();
+      block.predict();
+      auto expected = dense.correct(measurement);
+      auto state = block.correct(measurement);
+      BOOST_CHECK(arma::approx_equal(std::get<0>(expected), std::get<0>(state),
+                                     "absdiff", 1e-10));
+      BOOST_CHECK(arma::approx_equal(std::get<1>(expected), std::get<1>(state),
+                                     "absdiff", 1e-10));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(sample_interval_control_test) {
+  // the interval passed to predict should select the discretization
+  double q = 0.5;
+  arma::mat drift{{0, 1}, {0, 0}};
+  arma::mat diffusion{{0, 0}, {0, q}};
+  arma::mat measurement_matrix{{1, 0}};
+  arma::mat measurement_noise = arma::eye<arma::mat>(1, 1) * 0.1;
+  distribution::Gaussian initial(arma::zeros<arma::vec>(2),
+                                 arma::eye<arma::mat>(2, 2));
+
+  auto continuous = makeKalman(
+      map::ContinuousLinearGaussian(drift, diffusion),
+      map::LinearGaussian(measurement_matrix, measurement_noise), initial);
+  continuous.initialize();
+
+  for (double dt : {0.1, 0.3, 0.1}) {
+    arma::mat covariance{{dt * dt * dt / 3, dt * dt / 2}, {dt * dt / 2, dt}};
+    auto discrete = makeKalman(
+        map::LinearGaussian(arma::mat{{1, dt}, {0, 1}}, covariance * q),
+        map::LinearGaussian(measurement_matrix, measurement_noise), initial);
+    discrete.initialize();
+
+    // restart from the same initial state for every interval
+    continuous.initialize();
+    arma::vec measurement{dt};
+    continuous.predict(dt);
+    discrete.predict();
+    auto expected = discrete.correct(measurement);
+    auto state = continuous.correct(measurement);
+    BOOST_CHECK(arma::approx_equal(std::get<0>(expected), std::get<0>(state),
+                                   "absdiff", 1e-10));
+    BOOST_CHECK(arma::approx_equal(std::get<1>(expected), std::get<1>(state),
+                                   "absdiff", 1e-10));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(steady_state_test) {
+  // the frozen filters should converge to the estimates of the full one
+  double delta = 0.1;
+  arma::mat dynamic_matrix{
+      {1, 0, delta, 0}, {0, 1, 0, delta}, {0, 0, 1, 0}, {0, 0, 0, 1}};
+  arma::mat dynamic_noise = arma::eye<arma::mat>(4, 4) * 0.1;
+  arma::mat measurement_matrix{{1, 0, 0, 0}, {0, 1, 0, 0}};
+  arma::mat measurement_noise = arma::eye<arma::mat>(2, 2) * 0.1;
+  distribution::Gaussian initial(arma::zeros<arma::vec>(4),
+                                 arma::eye<arma::mat>(4, 4));
+  auto make = [&]() {
+    return makeKalman(
+        map::LinearGaussian(dynamic_matrix, dynamic_noise),
+        map::LinearGaussian(measurement_matrix, measurement_noise), initial);
+  };
+
+  auto full = make();
+  auto detected = make();
+  auto solved = make();
+  detected.detectSteadyState(1e-12);
+  solved.solveSteadyState();
+  BOOST_CHECK(!detected.isSteady());
+  BOOST_CHECK(solved.isSteady());
+
+  full.initialize();
+  detected.initialize();
+  solved.initialize();
+  filter::Kalman<map::LinearGaussian, map::LinearGaussian>::TCompeleteState
+      expected, state;
+  for (int t = 0; t < 300; t++) {
+    arma::vec measurement{std::sin(0.1 * t), 0.05 * t};
+    full.predict();
+    detected.predict();
+    solved.predict();
+    expected = full.correct(measurement);
+    state = detected.correct(measurement);
+    BOOST_CHECK(arma::approx_equal(std::get<0>(expected), std::get<0>(state),
+                                   "absdiff", 1e-8));
+    state = solved.correct(measurement);
+  }
+  BOOST_CHECK(detected.isSteady());
+  BOOST_CHECK(arma::approx_equal(std::get<0>(expected), std::get<0>(state),
+                                 "absdiff", 1e-8));
+  BOOST_CHECK(arma::approx_equal(std::get<1>(expected), std::get<1>(state),
+                                 "absdiff", 1e-10));
+}
+
+BOOST_AUTO_TEST_CASE(steady_state_failure_test) {
+  // an unconverged solution is reported and an unfrozen filter runs the full
+  // recursion again
+  double delta = 0.1;
+  arma::mat dynamic_matrix{{1, delta}, {0, 1}};
+  arma::mat dynamic_noise = arma::eye<arma::mat>(2, 2) * 0.1;
+  arma::mat measurement_matrix{{1, 0}};
+  arma::mat measurement_noise = arma::eye<arma::mat>(1, 1) * 0.1;
+  distribution::Gaussian initial(arma::zeros<arma::vec>(2),
+                                 arma::eye<arma::mat>(2, 2));
+  auto make = [&]() {
+    return makeKalman(
+        map::LinearGaussian(dynamic_matrix, dynamic_noise),
+        map::LinearGaussian(measurement_matrix, measurement_noise), initial);
+  };
+
+  auto full = make();
+  auto kalman = make();
+  BOOST_CHECK_THROW(kalman.solveSteadyState(1e-12, 1), std::runtime_error);
+  BOOST_CHECK(!kalman.isSteady());
+
+  kalman.solveSteadyState();
+  BOOST_CHECK(kalman.isSteady());
+  kalman.initialize();
+  BOOST_CHECK(kalman.isSteady());
+  kalman.unfreeze();
+  BOOST_CHECK(!kalman.isSteady());
+
+  full.initialize();
+  kalman.initialize();
+  for (int t = 0; t < 10; t++) {
+    arma::vec measurement{0.1 * t};
+    full.predict();
+    kalman.predict();
+    auto expected = full.correct(measurement);
+    auto state = kalman.correct(measurement);
+    BOOST_CHECK(arma::approx_equal(std::get<0>(expected), std::get<0>(state),
+                                   "absdiff", 1e-12));
+    BOOST_CHECK(arma::approx_equal(std::get<1>(expected), std::get<1>(state),
+                                   "absdiff", 1e-12));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(sequential_update_test) {
+  // independent sensors (diagonal R) are processed one by one, the result
+  // should match the joint update of the square-root filter
+  constexpr int measu_dim = 10;
+  arma::mat dynamic_matrix{{1, 0.1}, {0, 1}};
+  arma::mat dynamic_noise{{0.01, 0.005}, {0.005, 0.1}};
+  arma::mat measurement_matrix(measu_dim, 2);
+  for (int i = 0; i < measu_dim; i++) {
+    measurement_matrix(i, 0) = 1;
+    measurement_matrix(i, 1) = 0.2 * i - 1;
+  }
+  arma::mat measurement_noise =
+      arma::diagmat(arma::linspace<arma::vec>(0.1, 1, measu_dim));
+
+  auto dynamic_cpdf = distribution::makeConditional(
+      distribution::Gaussian(2),
+      map::LinearGaussian(dynamic_matrix, dynamic_noise));
+  auto measurement_cpdf = distribution::makeConditional(
+      distribution::Gaussian(measu_dim),
+      map::LinearGaussian(measurement_matrix, measurement_noise));
+  auto joint_process = process::makeHierarchical(
+      process::makeMarkov(dynamic_cpdf,
+                          distribution::Gaussian(arma::zeros<arma::vec>(2),
+                                                 arma::eye<arma::mat>(2, 2))),
+      process::makeMemoryless(measurement_cpdf));
+
+  auto kalman = filter::makeKalman(joint_process);
+  auto sr_kalman = filter::makeSquareRootKalman(joint_process);
+  kalman.initialize();
+  sr_kalman.initialize();
+  for (int t = 0; t < 20; t++) {
+    arma::vec measurement =
+        arma::linspace<arma::vec>(-0.1 * t, 0.1 * t, measu_dim);
+    kalman.predict();
+    sr_kalman.predict();
+    auto expected = sr_kalman.correct(measurement);
+    auto state = kalman.correct(measurement);
+    BOOST_CHECK(arma::approx_equal(std::get<0>(expected), std::get<0>(state),
+                                   "absdiff", 1e-8));
+    BOOST_CHECK(arma::approx_equal(std::get<1>(expected), std::get<1>(state),
+                                   "absdiff", 1e-8));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(gain_schedule_test) {
+  // filters sharing a schedule should match filters with own covariances
+  double delta = 0.1;
+  arma::mat dynamic_matrix{
+      {1, 0, delta, 0}, {0, 1, 0, delta}, {0, 0, 1, 0}, {0, 0, 0, 1}};
+  arma::mat dynamic_noise = arma::eye<arma::mat>(4, 4) * 0.1;
+  arma::mat measurement_matrix{{1, 0, 0, 0}, {0, 1, 0, 0}};
+  arma::mat measurement_noise{{0.1, 0.02}, {0.02, 0.1}};
+
+  auto dynamic_cpdf = distribution::makeConditional(
+      distribution::Gaussian(4),
+      map::LinearGaussian(dynamic_matrix, dynamic_noise));
+  auto measurement_cpdf = distribution::makeConditional(
+      distribution::Gaussian(2),
+      map::LinearGaussian(measurement_matrix, measurement_noise));
+  auto joint_process = process::makeHierarchical(
+      process::makeMarkov(dynamic_cpdf,
+                          distribution::Gaussian(arma::zeros<arma::vec>(4),
+                                                 arma::eye<arma::mat>(4, 4))),
+      process::makeMemoryless(measurement_cpdf));
+
+  // the last (converged) entry is reused after the schedule ends
+  auto schedule = filter::makeGainSchedule(joint_process);
+  BOOST_CHECK(schedule->isConverged());
+  BOOST_CHECK(schedule->size() < 300);
+
+  for (int track = 0; track < 3; track++) {
+    auto full = filter::makeKalman(joint_process);
+    auto scheduled = filter::makeKalman(joint_process);
+    scheduled.setGainSchedule(schedule);
+    full.initialize();
+    scheduled.initialize();
+    for (int t = 0; t < 300; t++) {
+      arma::vec measurement{std::sin(0.1 * t * (track + 1)), 0.05 * t};
+      full.predict();
+      scheduled.predict();
+      auto expected = full.correct(measurement);
+      auto state = scheduled.correct(measurement);
+      BOOST_CHECK(arma::approx_equal(std::get<0>(expected),
+                                     std::get<0>(state), "absdiff", 1e-8));
+      BOOST_CHECK(arma::approx_equal(std::get<1>(expected),
+                                     std::get<1>(state), "absdiff", 1e-8));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(gain_schedule_block_test) {
+  // a schedule built from block maps should match the block filter
+  constexpr unsigned int blocks = 3;
+  arma::mat dynamic_matrix{{1, 0.1}, {0, 1}};
+  arma::mat dynamic_noise{{0.01, 0.005}, {0.005, 0.1}};
+  arma::mat measurement_matrix{{1, 0}};
+  arma::mat measurement_noise = arma::eye<arma::mat>(1, 1) * 0.2;
+
+  auto dynamic_cpdf = distribution::makeConditional(
+      distribution::Gaussian(2 * blocks),
+      map::BlockLinearGaussian(dynamic_matrix, dynamic_noise, blocks));
+  auto measurement_cpdf = distribution::makeConditional(
+      distribution::Gaussian(blocks),
+      map::BlockLinearGaussian(measurement_matrix, measurement_noise, blocks));
+  auto joint_process = process::makeHierarchical(
+      process::makeMarkov(
+          dynamic_cpdf,
+          distribution::Gaussian(arma::zeros<arma::vec>(2 * blocks),
+                                 arma::eye<arma::mat>(2 * blocks, 2 * blocks))),
+      process::makeMemoryless(measurement_cpdf));
+
+  auto schedule = filter::makeGainSchedule(joint_process);
+  BOOST_CHECK(schedule->isConverged());
+
+  auto full = filter::makeKalman(joint_process);
+  auto scheduled = filter::makeKalman(joint_process);
+  scheduled.setGainSchedule(schedule);
+  full.initialize();
+  scheduled.initialize();
+  for (int t = 0; t < 50; t++) {
+    arma::vec measurement{0.5 * t, -0.2 * t, std::sin(0.1 * t)};
+    full.predict();
+    scheduled.predict();
+    auto expected = full.correct(measurement);
+    auto state = scheduled.correct(measurement);
+    BOOST_CHECK(arma::approx_equal(std::get<0>(expected), std::get<0>(state),
+                                   "absdiff", 1e-8));
+    BOOST_CHECK(arma::approx_equal(std::get<1>(expected), std::get<1>(state),
+                                   "absdiff", 1e-8));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(gain_schedule_validation_test) {
+  // schedules of other models or not converged ones are rejected, and
+  // repeated predictions keep the filter on the schedule
+  arma::mat dynamic_matrix{{1, 0.1}, {0, 1}};
+  arma::mat dynamic_noise{{0.01, 0.005}, {0.005, 0.1}};
+  arma::mat measurement_matrix{{1, 0}};
+  arma::mat measurement_noise{{0.2}};
+  distribution::Gaussian initial(arma::zeros<arma::vec>(2),
+                                 arma::eye<arma::mat>(2, 2));
+  auto joint_process = process::makeHierarchical(
+      process::makeMarkov(
+          distribution::makeConditional(
+              distribution::Gaussian(2),
+              map::LinearGaussian(dynamic_matrix, dynamic_noise)),
+          initial),
+      process::makeMemoryless(distribution::makeConditional(
+          distribution::Gaussian(1),
+          map::LinearGaussian(measurement_matrix, measurement_noise))));
+
+  auto scheduled = filter::makeKalman(joint_process);
+  BOOST_CHECK_THROW(
+      scheduled.setGainSchedule(filter::makeGainSchedule(joint_process, 2)),
+      std::invalid_argument);
+  auto other = std::make_shared<const filter::GainSchedule>(
+      dynamic_matrix, dynamic_noise, measurement_matrix, measurement_noise * 2,
+      initial.getCovariance());
+  BOOST_REQUIRE(other->isConverged());
+  BOOST_CHECK_THROW(scheduled.setGainSchedule(other), std::invalid_argument);
+  auto wider = std::make_shared<const filter::GainSchedule>(
+      dynamic_matrix, dynamic_noise, arma::eye<arma::mat>(2, 2),
+      arma::eye<arma::mat>(2, 2), initial.getCovariance());
+  BOOST_CHECK_THROW(scheduled.setGainSchedule(wider), std::invalid_argument);
+
+  scheduled.setGainSchedule(filter::makeGainSchedule(joint_process));
+  auto full = filter::makeKalman(joint_process);
+  full.initialize();
+  scheduled.initialize();
+  BOOST_CHECK_THROW(scheduled.correct(arma::vec{0}), std::logic_error);
+  for (int t = 0; t < 50; t++) {
+    arma::vec measurement{0.3 * t};
+    full.predict();
+    scheduled.predict();
+    if (t % 7 == 3) {
+      full.predict();
+      scheduled.predict();
+    }
+    auto expected = full.correct(measurement);
+    auto state = scheduled.correct(measurement);
+    BOOST_CHECK(arma::approx_equal(std::get<0>(expected), std::get<0>(state),
+                                   "absdiff", 1e-8));
+    BOOST_CHECK(arma::approx_equal(std::get<1>(expected), std::get<1>(state),
+                                   "absdiff", 1e-8));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(symmetric_covariance_test) {
+  // the covariances should stay exactly symmetric over a long run
+  arma::mat dynamic_matrix{{1, 0.1, 0.005}, {0, 1, 0.1}, {0, 0, 1}};
+  arma::mat dynamic_noise{
+      {1e-4, 5e-4, 1e-3}, {5e-4, 1e-2, 2e-2}, {1e-3, 2e-2, 1}};
+  arma::mat measurement_matrix{{1, 0, 0}, {0, 1, 0}};
+  arma::mat measurement_noise{{0.5, 0.1}, {0.1, 0.5}};
+  auto kalman = makeKalman(
+      map::LinearGaussian(dynamic_matrix, dynamic_noise),
+      map::LinearGaussian(measurement_matrix, measurement_noise),
+      distribution::Gaussian(arma::zeros<arma::vec>(3),
+                             arma::eye<arma::mat>(3, 3)));
+  auto sr_kalman = filter::makeSquareRootKalman(
+      process::makeHierarchical(
+          process::makeMarkov(
+              distribution::makeConditional(
+                  distribution::Gaussian(3),
+                  map::LinearGaussian(dynamic_matrix, dynamic_noise)),
+              distribution::Gaussian(arma::zeros<arma::vec>(3),
+                                     arma::eye<arma::mat>(3, 3))),
+          process::makeMemoryless(distribution::makeConditional(
+              distribution::Gaussian(2),
+              map::LinearGaussian(measurement_matrix, measurement_noise)))));
+
+  kalman.initialize();
+  sr_kalman.initialize();
+  bool symmetric = true;
+  for (int t = 0; t < 1000; t++) {
+    arma::vec measurement{std::sin(0.01 * t), std::cos(0.01 * t)};
+    kalman.predict();
+    sr_kalman.predict();
+    kalman.correctInPlace(measurement);
+    const arma::mat &covariance = kalman.getStateCovariance();
+    symmetric = symmetric && arma::approx_equal(covariance, covariance.t(),
+                                                "absdiff", 0.0);
+    auto expected = sr_kalman.correct(measurement);
+    BOOST_CHECK(arma::approx_equal(std::get<0>(expected),
+                                   kalman.getStateVector(), "absdiff", 1e-8));
+    BOOST_CHECK(arma::approx_equal(std::get<1>(expected), covariance,
+                                   "absdiff", 1e-8));
+  }
+  BOOST_CHECK(symmetric);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,146 @@
+#include <boost/test/unit_test.hpp>
+
+#include "ssmkit/filter/kalman.hpp"
+#include "ssmkit/map/linear_gaussian.hpp"
+#include "ssmkit/distribution/gaussian.hpp"
+#include "ssmkit/distribution/conditional.hpp"
+#include "ssmkit/process/markov.hpp"
+#include "ssmkit/process/memoryless.hpp"
+#include "ssmkit/process/hierarchical.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <tuple>
+
+// counts the heap allocations by replacing the allocation functions of
+// glibc, operator new and armadillo both end up here
+#if defined(__GLIBC__)
+
+namespace {
+std::atomic<bool> counting{false};
+std::atomic<std::size_t> allocations{0};
+
+void count() {
+  if (counting)
+    allocations++;
+}
+} // namespace
+
+extern "C" {
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t num, std::size_t size);
+void *__libc_realloc(void *ptr, std::size_t size);
+void *__libc_memalign(std::size_t alignment, std::size_t size);
+
+void *malloc(std::size_t size) {
+  count();
+  return __libc_malloc(size);
+}
+
+void *calloc(std::size_t num, std::size_t size) {
+  count();
+  return __libc_calloc(num, size);
+}
+
+void *realloc(void *ptr, std::size_t size) {
+  count();
+  return __libc_realloc(ptr, size);
+}
+
+void *aligned_alloc(std::size_t alignment, std::size_t size) {
+  count();
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **ptr, std::size_t alignment, std::size_t size) {
+  count();
+  *ptr = __libc_memalign(alignment, size);
+  return *ptr ? 0 : ENOMEM;
+}
+}
+
+using namespace ssmkit;
+
+namespace {
+// constant velocity in 3D, position measured with correlated noise
+auto makeProcess(const arma::mat &measurement_noise) {
+  constexpr double delta = 0.1;
+  arma::mat dynamic_matrix = arma::eye<arma::mat>(6, 6);
+  dynamic_matrix.submat(0, 3, 2, 5) = delta * arma::eye<arma::mat>(3, 3);
+  arma::mat dynamic_noise = 0.01 * arma::eye<arma::mat>(6, 6);
+  arma::mat measurement_matrix = arma::zeros<arma::mat>(3, 6);
+  measurement_matrix.submat(0, 0, 2, 2) = arma::eye<arma::mat>(3, 3);
+
+  auto dynamic_cpdf = distribution::makeConditional(
+      distribution::Gaussian(6),
+      map::LinearGaussian(dynamic_matrix, dynamic_noise));
+  auto measurement_cpdf = distribution::makeConditional(
+      distribution::Gaussian(3),
+      map::LinearGaussian(measurement_matrix, measurement_noise));
+  return process::makeHierarchical(
+      process::makeMarkov(dynamic_cpdf,
+                          distribution::Gaussian(arma::zeros<arma::vec>(6),
+                                                 arma::eye<arma::mat>(6, 6))),
+      process::makeMemoryless(measurement_cpdf));
+}
+
+// number of allocations of 100 steps after two warm-up steps
+template <class TFilter>
+std::size_t countStepAllocations(TFilter &kalman) {
+  arma::vec measurement(3);
+  kalman.initialize();
+  for (int t = 0; t < 102; t++) {
+    if (t == 2) {
+      allocations = 0;
+      counting = true;
+    }
+    measurement.fill(0.1 * t);
+    kalman.predict();
+    kalman.correctInPlace(measurement);
+  }
+  counting = false;
+  return allocations;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(filter_kalman_allocation);
+
+BOOST_AUTO_TEST_CASE(dense_step_test) {
+  arma::mat measurement_noise{
+      {0.1, 0.02, 0}, {0.02, 0.1, 0.02}, {0, 0.02, 0.1}};
+  auto process = makeProcess(measurement_noise);
+  auto kalman = filter::makeKalman(process);
+  BOOST_CHECK_EQUAL(countStepAllocations(kalman), 0u);
+
+  // the in-place step should give the same posterior as correct
+  auto reference = filter::makeKalman(process);
+  auto state = reference.initialize();
+  for (int t = 0; t < 102; t++) {
+    reference.predict();
+    state = reference.correct(arma::vec(3).fill(0.1 * t));
+  }
+  BOOST_CHECK(arma::approx_equal(kalman.getStateVector(), std::get<0>(state),
+                                 "absdiff", 1e-10));
+  BOOST_CHECK(arma::approx_equal(kalman.getStateCovariance(),
+                                 std::get<1>(state), "absdiff", 1e-10));
+}
+
+BOOST_AUTO_TEST_CASE(sequential_step_test) {
+  auto kalman =
+      filter::makeKalman(makeProcess(0.1 * arma::eye<arma::mat>(3, 3)));
+  BOOST_CHECK_EQUAL(countStepAllocations(kalman), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(steady_step_test) {
+  arma::mat measurement_noise{
+      {0.1, 0.02, 0}, {0.02, 0.1, 0.02}, {0, 0.02, 0.1}};
+  auto kalman = filter::makeKalman(makeProcess(measurement_noise));
+  kalman.solveSteadyState();
+  BOOST_CHECK_EQUAL(countStepAllocations(kalman), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+#endif // __GLIBC__
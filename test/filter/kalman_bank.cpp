@@ -0,0 +1,107 @@
+#include <boost/test/unit_test.hpp>
+
+#include "ssmkit/filter/kalman_bank.hpp"
+#include "ssmkit/map/linear_gaussian.hpp"
+#include "ssmkit/distribution/gaussian.hpp"
+#include "ssmkit/distribution/conditional.hpp"
+#include "ssmkit/process/markov.hpp"
+#include "ssmkit/process/memoryless.hpp"
+#include "ssmkit/process/hierarchical.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace ssmkit;
+
+BOOST_AUTO_TEST_SUITE(filter_kalman_bank);
+
+BOOST_AUTO_TEST_CASE(compare_dense_test) {
+  // every track should follow the dense Kalman equations, tracks without
+  // measurement only predict; a constant acceleration model with correlated
+  // position and acceleration measurements
+  constexpr unsigned int num_tracks = 5;
+  double delta = 0.1;
+  arma::mat F{{1, delta, delta * delta / 2}, {0, 1, delta}, {0, 0, 1}};
+  arma::mat Q{{0.1, 0.05, 0}, {0.05, 0.1, 0.02}, {0, 0.02, 0.1}};
+  arma::mat H{{1, 0, 0}, {0, 0, 1}};
+  arma::mat R{{0.2, 0.05}, {0.05, 0.1}};
+
+  auto dynamic_cpdf = distribution::makeConditional(
+      distribution::Gaussian(3), map::LinearGaussian(F, Q));
+  auto measurement_cpdf = distribution::makeConditional(
+      distribution::Gaussian(2), map::LinearGaussian(H, R));
+  auto joint_process = process::makeHierarchical(
+      process::makeMarkov(dynamic_cpdf,
+                          distribution::Gaussian(arma::zeros<arma::vec>(3),
+                                                 arma::eye<arma::mat>(3, 3))),
+      process::makeMemoryless(measurement_cpdf));
+
+  auto bank = filter::makeKalmanBank(joint_process, num_tracks);
+  bank.initialize();
+  BOOST_CHECK_EQUAL(bank.getNumTracks(), num_tracks);
+
+  std::vector<arma::vec> means(num_tracks, arma::zeros<arma::vec>(3));
+  std::vector<arma::mat> covs(num_tracks, arma::eye<arma::mat>(3, 3));
+  // a different initial state for one track
+  means[3] = arma::vec{1, -1, 0.5};
+  covs[3] = 2 * arma::eye<arma::mat>(3, 3);
+  covs[3](0, 2) = covs[3](2, 0) = 0.3;
+  bank.initialize(3, means[3], covs[3]);
+
+  for (int t = 0; t < 20; t++) {
+    arma::mat measurements(num_tracks, 2);
+    arma::uvec mask(num_tracks);
+    for (unsigned int k = 0; k < num_tracks; k++) {
+      measurements(k, 0) = 0.1 * t * k - 0.05 * t * t;
+      measurements(k, 1) = -0.1 + 0.01 * k;
+      mask(k) = (t + k) % 3 != 0;
+    }
+    bank.predict();
+    bank.correct(measurements, mask);
+
+    for (unsigned int k = 0; k < num_tracks; k++) {
+      means[k] = F * means[k];
+      covs[k] = F * covs[k] * F.t() + Q;
+      if (mask(k)) {
+        arma::mat gain = covs[k] * H.t() * arma::inv(H * covs[k] * H.t() + R);
+        means[k] += gain * (measurements.row(k).t() - H * means[k]);
+        covs[k] -= gain * H * covs[k];
+      }
+      BOOST_CHECK(
+          arma::approx_equal(bank.getMean(k), means[k], "absdiff", 1e-9));
+      BOOST_CHECK(
+          arma::approx_equal(bank.getCovariance(k), covs[k], "absdiff", 1e-9));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(indefinite_innovation_test) {
+  // an innovation covariance which is not positive definite is reported
+  // and the tracks keep their predicted states
+  arma::mat F = arma::eye<arma::mat>(2, 2);
+  arma::mat Q = arma::eye<arma::mat>(2, 2) * 0.01;
+  arma::mat H{{1, 0}};
+  arma::mat R{{-1}};
+
+  auto dynamic_cpdf = distribution::makeConditional(
+      distribution::Gaussian(2), map::LinearGaussian(F, Q));
+  auto measurement_cpdf = distribution::makeConditional(
+      distribution::Gaussian(1), map::LinearGaussian(H, R));
+  auto joint_process = process::makeHierarchical(
+      process::makeMarkov(dynamic_cpdf,
+                          distribution::Gaussian(arma::zeros<arma::vec>(2),
+                                                 arma::eye<arma::mat>(2, 2) *
+                                                     0.01)),
+      process::makeMemoryless(measurement_cpdf));
+
+  auto bank = filter::makeKalmanBank(joint_process, 3);
+  bank.initialize();
+  bank.predict();
+  const arma::mat predicted = bank.getCovariance(1);
+  BOOST_CHECK_THROW(bank.correct(arma::ones<arma::mat>(3, 1)),
+                    std::runtime_error);
+  BOOST_CHECK(arma::approx_equal(bank.getCovariance(1), predicted, "absdiff",
+                                 0.0));
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -15,6 +15,17 @@
 
 using namespace ssmkit;
 
+namespace {
+// an initial pdf with only the point methods required by process::Markov
+struct PointGaussian {
+  distribution::Gaussian gaussian;
+  arma::vec random() { return gaussian.random(); }
+  double likelihood(const arma::vec &rv) const {
+    return gaussian.likelihood(rv);
+  }
+};
+} // namespace
+
 BOOST_AUTO_TEST_SUITE(filter_particle);
 
 BOOST_AUTO_TEST_CASE(builder)
@@ -95,6 +106,84 @@ BOOST_AUTO_TEST_CASE(initializer)
   BOOST_CHECK_CLOSE(arma::accu(std::get<1>(cstate)), 1.0, 0.001);
 }
 
+BOOST_AUTO_TEST_CASE(initializer_weights)
+{
+  // the initial weights are the normalized likelihoods of the particles
+  unsigned int state_dim = 2;
+  unsigned int measu_dim = 2;
+  unsigned int num_particle = 7;
+
+  auto dynamic_model = map::LinearGaussian(arma::eye<arma::mat>(state_dim, state_dim),
+                                               arma::eye<arma::mat>(state_dim, state_dim));
+  auto measurement_model = map::LinearGaussian(arma::eye<arma::mat>(measu_dim, state_dim),
+                                                   arma::eye<arma::mat>(measu_dim, measu_dim));
+
+  auto dynamic_cpdf =
+      distribution::makeConditional(distribution::Gaussian(state_dim), dynamic_model);
+  auto measurement_cpdf = distribution::makeConditional(
+      distribution::Gaussian(measu_dim), measurement_model);
+
+  distribution::Gaussian initial_pdf(arma::vec{1, -1},
+                                     arma::mat{{2, 0.5}, {0.5, 1}});
+  auto state_process = process::makeMarkov(dynamic_cpdf, initial_pdf);
+  auto measurement_process = process::makeMemoryless(measurement_cpdf);
+
+  auto joint_process =
+      process::makeHierarchical(state_process, measurement_process);
+
+  auto resampler = filter::resampler::makeSystematic(
+      filter::resampler::criterion::ESS(num_particle * 0.8));
+
+  auto pfilter = filter::makeParticle(joint_process, resampler, num_particle);
+  auto cstate = pfilter.initialize();
+
+  const arma::mat &particles = std::get<0>(cstate);
+  BOOST_REQUIRE_EQUAL(particles.n_cols, num_particle);
+  arma::vec expected(num_particle);
+  for (unsigned int i = 0; i < num_particle; i++)
+    expected(i) = initial_pdf.likelihood(particles.col(i));
+  expected /= arma::accu(expected);
+  BOOST_CHECK(arma::approx_equal(std::get<1>(cstate), expected, "reldiff",
+                                 1e-9));
+}
+
+BOOST_AUTO_TEST_CASE(initializer_point_pdf)
+{
+  // pdfs without the batch methods are sampled and weighted per particle
+  unsigned int state_dim = 2;
+  unsigned int num_particle = 7;
+
+  auto dynamic_cpdf = distribution::makeConditional(
+      distribution::Gaussian(state_dim),
+      map::LinearGaussian(arma::eye<arma::mat>(state_dim, state_dim),
+                          arma::eye<arma::mat>(state_dim, state_dim)));
+  auto measurement_cpdf = distribution::makeConditional(
+      distribution::Gaussian(state_dim),
+      map::LinearGaussian(arma::eye<arma::mat>(state_dim, state_dim),
+                          arma::eye<arma::mat>(state_dim, state_dim)));
+
+  PointGaussian initial_pdf{distribution::Gaussian(
+      arma::vec{1, -1}, arma::mat{{2, 0.5}, {0.5, 1}})};
+  auto joint_process = process::makeHierarchical(
+      process::makeMarkov(dynamic_cpdf, initial_pdf),
+      process::makeMemoryless(measurement_cpdf));
+
+  auto resampler = filter::resampler::makeSystematic(
+      filter::resampler::criterion::ESS(num_particle * 0.8));
+
+  auto pfilter = filter::makeParticle(joint_process, resampler, num_particle);
+  auto cstate = pfilter.initialize();
+
+  const arma::mat &particles = std::get<0>(cstate);
+  BOOST_REQUIRE_EQUAL(particles.n_cols, num_particle);
+  arma::vec expected(num_particle);
+  for (unsigned int i = 0; i < num_particle; i++)
+    expected(i) = initial_pdf.likelihood(particles.col(i));
+  expected /= arma::accu(expected);
+  BOOST_CHECK(arma::approx_equal(std::get<1>(cstate), expected, "reldiff",
+                                 1e-9));
+}
+
 BOOST_AUTO_TEST_CASE(predict)
 {
   unsigned int state_dim = 4;
@@ -32,4 +32,20 @@ BOOST_AUTO_TEST_CASE(ordered_number_generator)
   }
 }
 
+BOOST_AUTO_TEST_CASE(ordered_number_generator_source)
+{
+  struct AlwaysTrue {
+    bool operator()(arma::vec t) { return true; }
+  };
+
+  // offset taken from the given source
+  double offset = 0.25;
+  auto resampler = filter::resampler::makeSystematic(
+      AlwaysTrue(), [&offset]() { return offset; });
+  int N = 4;
+  auto u = resampler.generateOrderedNumbers(N);
+  BOOST_CHECK(arma::approx_equal(u, arma::vec{0.0625, 0.3125, 0.5625, 0.8125},
+                                 "absdiff", 1e-12));
+}
+
 BOOST_AUTO_TEST_SUITE_END();
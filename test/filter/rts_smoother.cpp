@@ -0,0 +1,158 @@
+#include <boost/test/unit_test.hpp>
+
+#include "ssmkit/filter/rts_smoother.hpp"
+#include "ssmkit/map/linear_gaussian.hpp"
+#include "ssmkit/distribution/gaussian.hpp"
+#include "ssmkit/distribution/conditional.hpp"
+#include "ssmkit/process/markov.hpp"
+#include "ssmkit/process/memoryless.hpp"
+#include "ssmkit/process/hierarchical.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace ssmkit;
+
+namespace {
+const arma::mat dynamic_matrix{{1, 0.1}, {0, 1}};
+const arma::mat dynamic_noise{{0.01, 0.005}, {0.005, 0.1}};
+const arma::mat measurement_matrix{{1, 0}};
+const arma::mat measurement_noise = 0.5 * arma::eye<arma::mat>(1, 1);
+const arma::vec initial_mean{1, 0};
+const arma::mat initial_cov = arma::eye<arma::mat>(2, 2);
+
+auto makeProcess() {
+  auto dynamic_cpdf = distribution::makeConditional(
+      distribution::Gaussian(2),
+      map::LinearGaussian(dynamic_matrix, dynamic_noise));
+  auto measurement_cpdf = distribution::makeConditional(
+      distribution::Gaussian(1),
+      map::LinearGaussian(measurement_matrix, measurement_noise));
+  return process::makeHierarchical(
+      process::makeMarkov(dynamic_cpdf,
+                          distribution::Gaussian(initial_mean, initial_cov)),
+      process::makeMemoryless(measurement_cpdf));
+}
+
+std::vector<arma::vec> makeMeasurements(int length) {
+  std::vector<arma::vec> measurements;
+  for (int t = 0; t < length; t++)
+    measurements.push_back(arma::vec{std::sin(0.3 * t) + 0.1 * t});
+  return measurements;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(filter_rts_smoother);
+
+BOOST_AUTO_TEST_CASE(joint_posterior_test) {
+  // the smoothed moments are the marginals of the joint Gaussian posterior
+  // of x_0, ..., x_T given z_1, ..., z_T
+  constexpr int length = 15;
+  const auto measurements = makeMeasurements(length);
+
+  // prior of the stacked states, Cov(x_s, x_t) = F^(t-s) P_s for s <= t
+  const arma::uword n = 2, size = n * (length + 1);
+  arma::vec prior_mean(size);
+  arma::mat prior_cov(size, size);
+  std::vector<arma::mat> marginal_covs{initial_cov};
+  prior_mean.subvec(0, n - 1) = initial_mean;
+  for (int t = 1; t <= length; t++) {
+    prior_mean.subvec(t * n, t * n + n - 1) =
+        dynamic_matrix * prior_mean.subvec(t * n - n, t * n - 1);
+    marginal_covs.push_back(dynamic_matrix * marginal_covs.back() *
+                                dynamic_matrix.t() +
+                            dynamic_noise);
+  }
+  for (int s = 0; s <= length; s++) {
+    arma::mat cross = marginal_covs[s];
+    for (int t = s; t <= length; t++) {
+      prior_cov.submat(t * n, s * n, t * n + n - 1, s * n + n - 1) = cross;
+      prior_cov.submat(s * n, t * n, s * n + n - 1, t * n + n - 1) =
+          cross.t();
+      cross = dynamic_matrix * cross;
+    }
+  }
+
+  // measurements of x_1, ..., x_T
+  arma::mat observe = arma::zeros<arma::mat>(length, size);
+  arma::vec z(length);
+  for (int t = 1; t <= length; t++) {
+    observe.submat(t - 1, t * n, t - 1, t * n + n - 1) = measurement_matrix;
+    z(t - 1) = measurements[t - 1](0);
+  }
+  const arma::mat cross = prior_cov * observe.t();
+  const arma::mat gain = cross * arma::inv_sympd(
+                                     observe * cross +
+                                     measurement_noise(0, 0) *
+                                         arma::eye<arma::mat>(length, length));
+  const arma::vec post_mean = prior_mean + gain * (z - observe * prior_mean);
+  const arma::mat post_cov = prior_cov - gain * cross.t();
+
+  auto smoother = filter::makeRTSSmoother(makeProcess());
+  smoother.smooth(measurements);
+  BOOST_CHECK_EQUAL(smoother.size(), arma::uword(length + 1));
+  for (int t = 0; t <= length; t++) {
+    BOOST_CHECK(arma::approx_equal(smoother.getMean(t),
+                                   post_mean.subvec(t * n, t * n + n - 1),
+                                   "absdiff", 1e-8));
+    BOOST_CHECK(arma::approx_equal(
+        smoother.getCovariance(t),
+        post_cov.submat(t * n, t * n, t * n + n - 1, t * n + n - 1),
+        "absdiff", 1e-8));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(fixed_lag_test) {
+  // the estimate of a fixed-lag step is the fixed-interval estimate of
+  // step t - L from the measurements up to t
+  constexpr int length = 20, lag = 4;
+  const auto measurements = makeMeasurements(length);
+
+  auto smoother = filter::makeRTSSmoother(makeProcess(), lag);
+  smoother.initialize();
+  for (int t = 1; t <= length; t++) {
+    const bool available = smoother.step(measurements[t - 1]);
+    BOOST_CHECK_EQUAL(available, t >= lag);
+    if (!available)
+      continue;
+
+    auto reference = filter::makeRTSSmoother(makeProcess());
+    reference.smooth(std::vector<arma::vec>(measurements.begin(),
+                                            measurements.begin() + t));
+    BOOST_CHECK(arma::approx_equal(smoother.getLaggedMean(),
+                                   reference.getMean(t - lag), "absdiff",
+                                   1e-8));
+    BOOST_CHECK(arma::approx_equal(smoother.getLaggedCovariance(),
+                                   reference.getCovariance(t - lag),
+                                   "absdiff", 1e-8));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(invalid_use_test) {
+  // no backward pass before initialize() or in fixed-lag mode, and no access
+  // to steps which have left the ring
+  constexpr int lag = 2;
+  const auto measurements = makeMeasurements(6);
+
+  auto interval = filter::makeRTSSmoother(makeProcess());
+  BOOST_CHECK_THROW(interval.smooth(), std::logic_error);
+  BOOST_CHECK_THROW(interval.step(measurements[0]), std::logic_error);
+  interval.smooth(measurements);
+  BOOST_CHECK_NO_THROW(interval.getMean(0));
+  BOOST_CHECK_THROW(interval.getMean(measurements.size() + 1),
+                    std::out_of_range);
+
+  auto lagged = filter::makeRTSSmoother(makeProcess(), lag);
+  lagged.initialize();
+  for (const auto &measurement : measurements)
+    lagged.step(measurement);
+  BOOST_CHECK_THROW(lagged.smooth(), std::logic_error);
+  const arma::uword last = measurements.size();
+  BOOST_CHECK_NO_THROW(lagged.getMean(last));
+  BOOST_CHECK_NO_THROW(lagged.getCovariance(last - lag));
+  BOOST_CHECK_THROW(lagged.getMean(last - lag - 1), std::out_of_range);
+  BOOST_CHECK_THROW(lagged.getCovariance(0), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,106 @@
+#include <boost/test/unit_test.hpp>
+
+#include "ssmkit/filter/kalman.hpp"
+#include "ssmkit/filter/square_root_kalman.hpp"
+#include "ssmkit/map/linear_gaussian.hpp"
+#include "ssmkit/distribution/gaussian.hpp"
+#include "ssmkit/distribution/conditional.hpp"
+#include "ssmkit/process/markov.hpp"
+#include "ssmkit/process/memoryless.hpp"
+#include "ssmkit/process/hierarchical.hpp"
+
+#include <tuple>
+
+using namespace ssmkit;
+
+namespace {
+// constant velocity model in the plane with the position measured
+auto makeProcess(const arma::mat &dynamic_noise,
+                 const arma::mat &measurement_noise) {
+  double delta = 0.1;
+  arma::mat dynamic_matrix{
+      {1, 0, delta, 0}, {0, 1, 0, delta}, {0, 0, 1, 0}, {0, 0, 0, 1}};
+  arma::mat measurement_matrix{{1, 0, 0, 0}, {0, 1, 0, 0}};
+
+  auto dynamic_cpdf = distribution::makeConditional(
+      distribution::Gaussian(4),
+      map::LinearGaussian(dynamic_matrix, dynamic_noise));
+  auto measurement_cpdf = distribution::makeConditional(
+      distribution::Gaussian(2),
+      map::LinearGaussian(measurement_matrix, measurement_noise));
+  return process::makeHierarchical(
+      process::makeMarkov(dynamic_cpdf,
+                          distribution::Gaussian(arma::zeros<arma::vec>(4),
+                                                 arma::eye<arma::mat>(4, 4))),
+      process::makeMemoryless(measurement_cpdf));
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(filter_square_root_kalman);
+
+BOOST_AUTO_TEST_CASE(compare_kalman_test) {
+  // the square-root filter should give the same estimates as Kalman
+  auto joint_process = makeProcess(arma::mat{{0.1, 0, 0.05, 0},
+                                             {0, 0.1, 0, 0.05},
+                                             {0.05, 0, 0.1, 0},
+                                             {0, 0.05, 0, 0.1}},
+                                   arma::mat{{0.1, 0.02}, {0.02, 0.1}});
+
+  auto kalman = filter::makeKalman(joint_process);
+  auto sr_kalman = filter::makeSquareRootKalman(joint_process);
+
+  kalman.initialize();
+  sr_kalman.initialize();
+  for (int t = 0; t < 50; t++) {
+    arma::vec measurement{0.5 * t, -0.2 * t};
+    kalman.predict();
+    sr_kalman.predict();
+    auto expected = kalman.correct(measurement);
+    auto state = sr_kalman.correct(measurement);
+    BOOST_CHECK(arma::approx_equal(std::get<0>(expected), std::get<0>(state),
+                                   "absdiff", 1e-8));
+    BOOST_CHECK(arma::approx_equal(std::get<1>(expected), std::get<1>(state),
+                                   "absdiff", 1e-8));
+  }
+  // the covariance is symmetric by construction
+  arma::mat covariance = std::get<1>(sr_kalman.correct(arma::vec{0, 0}));
+  BOOST_CHECK(arma::approx_equal(covariance, covariance.t(), "absdiff", 1e-12));
+
+  // the in-place step keeps the same posterior in the filter
+  kalman.predict();
+  sr_kalman.predict();
+  kalman.correctInPlace(arma::vec{1, 1});
+  sr_kalman.correctInPlace(arma::vec{1, 1});
+  BOOST_CHECK(arma::approx_equal(kalman.getStateVector(),
+                                 sr_kalman.getStateVector(), "absdiff", 1e-8));
+  BOOST_CHECK(arma::approx_equal(kalman.getStateCovariance(),
+                                 sr_kalman.getStateCovariance(), "absdiff",
+                                 1e-8));
+}
+
+BOOST_AUTO_TEST_CASE(singular_noise_test) {
+  // noise driving only the velocities and a rank deficient measurement noise
+  // have no Cholesky factor, the estimates should still match Kalman
+  auto joint_process =
+      makeProcess(arma::diagmat(arma::vec{0, 0, 0.1, 0.1}),
+                  arma::mat{{0.1, 0.1}, {0.1, 0.1}});
+
+  auto kalman = filter::makeKalman(joint_process);
+  auto sr_kalman = filter::makeSquareRootKalman(joint_process);
+
+  kalman.initialize();
+  sr_kalman.initialize();
+  for (int t = 0; t < 50; t++) {
+    arma::vec measurement{0.5 * t, -0.2 * t};
+    kalman.predict();
+    sr_kalman.predict();
+    auto expected = kalman.correct(measurement);
+    auto state = sr_kalman.correct(measurement);
+    BOOST_CHECK(arma::approx_equal(std::get<0>(expected), std::get<0>(state),
+                                   "absdiff", 1e-8));
+    BOOST_CHECK(arma::approx_equal(std::get<1>(expected), std::get<1>(state),
+                                   "absdiff", 1e-8));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,119 @@
+#include <boost/test/unit_test.hpp>
+
+#include "ssmkit/filter/kalman.hpp"
+#include "ssmkit/filter/unscented.hpp"
+#include "ssmkit/map/linear_gaussian.hpp"
+#include "ssmkit/distribution/gaussian.hpp"
+#include "ssmkit/distribution/conditional.hpp"
+#include "ssmkit/process/markov.hpp"
+#include "ssmkit/process/memoryless.hpp"
+#include "ssmkit/process/hierarchical.hpp"
+
+#include <cmath>
+#include <tuple>
+
+using namespace ssmkit;
+
+namespace {
+// linear map without batch method, the points are mapped one by one
+struct PointwiseLinear {
+  using TParameter = std::tuple<arma::vec, arma::mat>;
+  using TConditionVAR = arma::vec;
+
+  TParameter operator()(const TConditionVAR &x) const {
+    return std::make_tuple(arma::vec(transfer * x), covariance);
+  }
+
+  arma::mat transfer;
+  arma::mat covariance;
+};
+
+// element-wise square with additive noise
+struct Square {
+  using TParameter = std::tuple<arma::vec, arma::mat>;
+  using TConditionVAR = arma::vec;
+
+  TParameter operator()(const TConditionVAR &x) const {
+    return std::make_tuple(arma::vec(arma::square(x)), covariance);
+  }
+
+  arma::mat covariance;
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(filter_unscented);
+
+BOOST_AUTO_TEST_CASE(compare_kalman_test) {
+  // for linear maps the unscented transform is exact, both the batch and
+  // the pointwise path should give the Kalman estimates
+  arma::mat dynamic_matrix{{1, 0.1}, {0, 1}};
+  arma::mat dynamic_noise{{0.01, 0.005}, {0.005, 0.1}};
+  arma::mat measurement_matrix{{1, 0}, {1, 1}};
+  arma::mat measurement_noise{{0.5, 0.1}, {0.1, 0.5}};
+  distribution::Gaussian initial(arma::vec{1, 0}, arma::eye<arma::mat>(2, 2));
+
+  auto linear_process = process::makeHierarchical(
+      process::makeMarkov(
+          distribution::makeConditional(
+              distribution::Gaussian(2),
+              map::LinearGaussian(dynamic_matrix, dynamic_noise)),
+          initial),
+      process::makeMemoryless(distribution::makeConditional(
+          distribution::Gaussian(2),
+          map::LinearGaussian(measurement_matrix, measurement_noise))));
+  auto pointwise_process = process::makeHierarchical(
+      process::makeMarkov(
+          distribution::makeConditional(
+              distribution::Gaussian(2),
+              PointwiseLinear{dynamic_matrix, dynamic_noise}),
+          initial),
+      process::makeMemoryless(distribution::makeConditional(
+          distribution::Gaussian(2),
+          PointwiseLinear{measurement_matrix, measurement_noise})));
+
+  auto kalman = filter::makeKalman(linear_process);
+  auto batch_ukf = filter::makeUnscented(linear_process, 0.5);
+  auto pointwise_ukf = filter::makeUnscented(pointwise_process);
+
+  kalman.initialize();
+  batch_ukf.initialize();
+  pointwise_ukf.initialize();
+  for (int t = 0; t < 20; t++) {
+    arma::vec measurement{std::sin(0.3 * t), std::cos(0.3 * t)};
+    kalman.predict();
+    batch_ukf.predict();
+    pointwise_ukf.predict();
+    auto expected = kalman.correct(measurement);
+    for (const auto &state : {batch_ukf.correct(measurement),
+                              pointwise_ukf.correct(measurement)}) {
+      BOOST_CHECK(arma::approx_equal(std::get<0>(expected),
+                                     std::get<0>(state), "absdiff", 1e-8));
+      BOOST_CHECK(arma::approx_equal(std::get<1>(expected),
+                                     std::get<1>(state), "absdiff", 1e-8));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(quadratic_prediction_test) {
+  // for x ~ N(m, p) the moments of x^2 are m^2 + p and 4 m^2 p + 2 p^2,
+  // which the transform matches with the default parameters
+  constexpr double m = 0.7, p = 0.3, q = 0.01;
+  auto nonlinear_process = process::makeHierarchical(
+      process::makeMarkov(
+          distribution::makeConditional(distribution::Gaussian(1),
+                                        Square{q * arma::eye<arma::mat>(1, 1)}),
+          distribution::Gaussian(arma::vec{m}, p * arma::eye<arma::mat>(1, 1))),
+      process::makeMemoryless(distribution::makeConditional(
+          distribution::Gaussian(1),
+          map::LinearGaussian(arma::eye<arma::mat>(1, 1),
+                              arma::eye<arma::mat>(1, 1)))));
+
+  auto ukf = filter::makeUnscented(nonlinear_process);
+  ukf.initialize();
+  ukf.predict();
+  BOOST_CHECK_CLOSE(ukf.getPredictedStateVector()(0), m * m + p, 1e-8);
+  BOOST_CHECK_CLOSE(ukf.getPredictedStateCovariance()(0, 0),
+                    4 * m * m * p + 2 * p * p + q, 1e-8);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
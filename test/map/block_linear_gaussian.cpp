@@ -0,0 +1,35 @@
+#include <boost/test/unit_test.hpp>
+
+#include "ssmkit/map/block_linear_gaussian.hpp"
+
+#include <tuple>
+
+using namespace ssmkit;
+
+BOOST_AUTO_TEST_SUITE(map_block_linear_gaussian);
+
+BOOST_AUTO_TEST_CASE(dense_equivalence) {
+  // the block-wise products equal those of the Kronecker products
+  constexpr unsigned int blocks = 3;
+  arma::mat transfer{{1, 0.1}, {0, 1}, {0.5, 0}};
+  arma::mat covariance{{2, 0.5, 0}, {0.5, 1, 0.2}, {0, 0.2, 3}};
+  map::BlockLinearGaussian model(transfer, covariance, blocks);
+  const arma::mat eye = arma::eye<arma::mat>(blocks, blocks);
+  const arma::mat dense_transfer = arma::kron(eye, transfer);
+
+  const arma::vec x{1, -1, 2, 0.5, -3, 4};
+  auto parameters = model(x);
+  BOOST_CHECK(arma::approx_equal(std::get<0>(parameters),
+                                 arma::vec(dense_transfer * x), "absdiff",
+                                 1e-12));
+  BOOST_CHECK(arma::approx_equal(std::get<1>(parameters),
+                                 arma::kron(eye, covariance), "absdiff", 0.0));
+
+  const arma::mat xs{{1, 2}, {-1, 0}, {2, 1}, {0.5, -2}, {-3, 1}, {4, 0}};
+  auto batch_parameters = model.batch(xs);
+  BOOST_CHECK(arma::approx_equal(std::get<0>(batch_parameters),
+                                 arma::mat(dense_transfer * xs), "absdiff",
+                                 1e-12));
+}
+
+BOOST_AUTO_TEST_SUITE_END();
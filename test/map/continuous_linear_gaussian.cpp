@@ -0,0 +1,53 @@
+#include <boost/test/unit_test.hpp>
+
+#include "ssmkit/map/continuous_linear_gaussian.hpp"
+
+#include <tuple>
+
+using namespace ssmkit;
+
+BOOST_AUTO_TEST_SUITE(map_continuous_linear_gaussian);
+
+BOOST_AUTO_TEST_CASE(constant_velocity_discretization) {
+  // white noise acceleration with spectral density q
+  double q = 0.5;
+  arma::mat drift{{0, 1}, {0, 0}};
+  arma::mat diffusion{{0, 0}, {0, q}};
+  // small cache to exercise replacement
+  map::ContinuousLinearGaussian model(drift, diffusion, 2);
+  arma::vec x{1, 2};
+
+  for (double dt : {0.1, 0.5, 0.1, 2.0, 0.5, 0.5, 0.1}) {
+    arma::mat transfer{{1, dt}, {0, 1}};
+    arma::mat covariance{{dt * dt * dt / 3, dt * dt / 2}, {dt * dt / 2, dt}};
+    covariance *= q;
+
+    auto parameters = model(x, dt);
+    const auto &step = model.discretization(dt);
+    BOOST_CHECK_EQUAL(step.dt, dt);
+    BOOST_CHECK(arma::approx_equal(step.transfer, transfer, "absdiff", 1e-10));
+    BOOST_CHECK(
+        arma::approx_equal(step.covariance, covariance, "absdiff", 1e-10));
+    BOOST_CHECK(arma::approx_equal(std::get<0>(parameters),
+                                   arma::vec(transfer * x), "absdiff", 1e-10));
+    BOOST_CHECK_EQUAL(&std::get<1>(parameters), &step.covariance);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(copied_cache_references) {
+  // the filters hold copies of the map, the entries of a copy should not
+  // move when the copy caches more intervals
+  map::ContinuousLinearGaussian original(arma::mat{{0, 1}, {0, 0}},
+                                         arma::mat{{0, 0}, {0, 1}}, 4);
+  original.discretization(0.1);
+  map::ContinuousLinearGaussian model(original);
+
+  const auto &first = model.discretization(0.1);
+  const arma::mat transfer = first.transfer;
+  for (double dt : {0.2, 0.3, 0.1})
+    model.discretization(dt);
+  BOOST_CHECK_EQUAL(&model.discretization(0.1), &first);
+  BOOST_CHECK(arma::approx_equal(first.transfer, transfer, "absdiff", 0.0));
+}
+
+BOOST_AUTO_TEST_SUITE_END();
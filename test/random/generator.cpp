@@ -41,4 +41,32 @@ BOOST_AUTO_TEST_CASE(multithread) {
   }
 }
 
+// thread task, draws from the stream of the thread
+void sample_stream(double *r, unsigned int stream){
+  uniform_real_distribution<double> dist;
+  ssmkit::random::setSeed(2017, stream);
+  *r = dist(ssmkit::random::Generator::get().getGenerator());
+}
+
+BOOST_AUTO_TEST_CASE(multithread_streams) {
+  constexpr unsigned int n = 50;
+  array<double, n> samples;
+  array<double, n> expected;
+  array<thread, n> thrd;
+
+  // sequential reference
+  for (unsigned int i = 0; i < n; ++i)
+    sample_stream(&expected[i], i);
+
+  for (int repeat = 0; repeat < 5; repeat++) {
+    for (unsigned int i = 0; i < n; ++i)
+      thrd[i] = thread(sample_stream, &samples[i], i);
+    for_each(thrd.begin(), thrd.end(), [](auto &t) { t.join(); });
+    // same result regardless of threads and scheduling
+    BOOST_CHECK(samples == expected);
+  }
+  // different streams should differ
+  BOOST_CHECK(expected[0] != expected[1]);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,52 @@
+#include <boost/test/unit_test.hpp>
+
+#include "ssmkit/random/generator.hpp"
+#include "ssmkit/random/normal.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace ssmkit;
+
+BOOST_AUTO_TEST_SUITE(random_normal);
+
+// Number of Monte-Carlo runs
+constexpr int mc_n = 2000000;
+
+BOOST_AUTO_TEST_CASE(mc_test_moments) {
+  random::Normal normal;
+  random::setRandomSeed();
+  std::vector<double> samples(mc_n);
+  normal.fill(random::Generator::get().getGenerator(), samples.data(), mc_n);
+
+  double m1 = 0, m2 = 0, m4 = 0, tail = 0, above_one = 0;
+  for (const double &x : samples) {
+    m1 += x;
+    m2 += x * x;
+    m4 += x * x * x * x;
+    // beyond the right-most layer of the ziggurat
+    tail += std::abs(x) > 3.442619855899;
+    above_one += x > 1.0;
+  }
+
+  BOOST_CHECK_SMALL(m1 / mc_n, 0.005);
+  BOOST_CHECK_CLOSE(m2 / mc_n, 1.0, 0.5);
+  BOOST_CHECK_CLOSE(m4 / mc_n, 3.0, 2.0);
+  BOOST_CHECK_CLOSE(above_one / mc_n, 0.158655, 1.0);
+  BOOST_CHECK_CLOSE(tail / mc_n, 5.7612e-4, 10.0);
+}
+
+BOOST_AUTO_TEST_CASE(reproducible) {
+  // same seed should give the same sequence
+  random::Normal normal;
+  std::vector<double> a(100), b(100);
+
+  random::setSeed(1234);
+  normal.fill(random::Generator::get().getGenerator(), a.data(), a.size());
+  random::setSeed(1234);
+  normal.fill(random::Generator::get().getGenerator(), b.data(), b.size());
+
+  BOOST_CHECK(a == b);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,64 @@
+#include <boost/test/unit_test.hpp>
+
+#include "ssmkit/random/philox.hpp"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <random>
+
+using namespace ssmkit;
+
+BOOST_AUTO_TEST_SUITE(random_philox);
+
+BOOST_AUTO_TEST_CASE(known_answer) {
+  // known answer test vectors of Random123 for philox4x32_10
+  using random::Philox;
+  BOOST_CHECK(Philox::generate({{0, 0, 0, 0}}, {{0, 0}}) ==
+              (Philox::TBlock{{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}}));
+  BOOST_CHECK(Philox::generate({{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}},
+                               {{0xffffffff, 0xffffffff}}) ==
+              (Philox::TBlock{{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}}));
+  BOOST_CHECK(Philox::generate({{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}},
+                               {{0xa4093822, 0x299f31d0}}) ==
+              (Philox::TBlock{{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}));
+}
+
+BOOST_AUTO_TEST_CASE(streams) {
+  random::Philox a(42, 0), b(42, 0), c(42, 1), d(43, 0);
+  std::array<std::uint32_t, 64> sa, sb, sc, sd;
+  std::generate(sa.begin(), sa.end(), std::ref(a));
+  std::generate(sb.begin(), sb.end(), std::ref(b));
+  std::generate(sc.begin(), sc.end(), std::ref(c));
+  std::generate(sd.begin(), sd.end(), std::ref(d));
+
+  // same (seed, stream) gives same sequence
+  BOOST_CHECK(sa == sb);
+  // different stream or seed gives different sequence
+  BOOST_CHECK(sa != sc);
+  BOOST_CHECK(sa != sd);
+}
+
+BOOST_AUTO_TEST_CASE(discard) {
+  for (unsigned long long z = 0; z < 20; ++z) {
+    random::Philox a(7, 3), b(7, 3);
+    for (unsigned long long i = 0; i < z; ++i)
+      a();
+    b.discard(z);
+    BOOST_CHECK_EQUAL(a(), b());
+    BOOST_CHECK(a == b);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(uniform) {
+  // usable with standard distributions
+  random::Philox gen(2017);
+  std::uniform_real_distribution<double> dist;
+  constexpr int n = 1000000;
+  double mean = 0;
+  for (int i = 0; i < n; ++i)
+    mean += dist(gen) / n;
+  BOOST_CHECK_CLOSE(mean, 0.5, 0.5);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,64 @@
+#include <boost/test/unit_test.hpp>
+
+#include "ssmkit/random/normal.hpp"
+#include "ssmkit/random/sobol.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace ssmkit;
+
+BOOST_AUTO_TEST_SUITE(random_sobol);
+
+BOOST_AUTO_TEST_CASE(unscrambled_points) {
+  // first points of the Sobol sequence in three dimensions
+  const double expected[8][3] = {
+      {0, 0, 0},           {0.5, 0.5, 0.5},     {0.75, 0.25, 0.25},
+      {0.25, 0.75, 0.75},  {0.375, 0.375, 0.625}, {0.875, 0.875, 0.125},
+      {0.625, 0.125, 0.875}, {0.125, 0.625, 0.375}};
+  random::Sobol sobol(3, false);
+  std::vector<double> points(3 * 8);
+  sobol.uniform(points.data(), 8);
+  for (int i = 0; i < 8; ++i)
+    for (int j = 0; j < 3; ++j)
+      BOOST_CHECK_SMALL(points[3 * i + j] - expected[i][j], 1e-9);
+
+  // restart gives the same points
+  sobol.reset();
+  std::vector<double> again(3 * 8);
+  sobol.uniform(again.data(), 8);
+  BOOST_CHECK(points == again);
+}
+
+BOOST_AUTO_TEST_CASE(scrambled_stratification) {
+  // every one dimensional projection of the first 2^m points of the
+  // scrambled sequence has exactly one point in every interval of 2^-m
+  constexpr unsigned int dim = 40;
+  constexpr unsigned int n = 1 << 12;
+  random::setRandomSeed();
+  random::Sobol sobol(dim);
+  std::vector<double> points(dim * n);
+  sobol.uniform(points.data(), n);
+
+  for (unsigned int j = 0; j < dim; ++j) {
+    std::vector<int> count(n, 0);
+    for (unsigned int i = 0; i < n; ++i)
+      ++count[static_cast<unsigned int>(points[dim * i + j] * n)];
+    bool stratified = true;
+    for (const int &c : count)
+      stratified = stratified && c == 1;
+    BOOST_CHECK(stratified);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(normal_quantile) {
+  BOOST_CHECK_SMALL(random::normalQuantile(0.5), 1e-12);
+  BOOST_CHECK_CLOSE(random::normalQuantile(0.975), 1.959963984540054, 1e-9);
+  BOOST_CHECK_CLOSE(random::normalQuantile(1e-10), -6.361340902404056, 1e-9);
+  for (double p = 1e-12; p < 1; p *= 1.5) {
+    const double x = random::normalQuantile(p);
+    BOOST_CHECK_CLOSE(0.5 * std::erfc(-x / std::sqrt(2.0)), p, 1e-9);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END();